@@ -31,6 +31,7 @@ string representToken(Token t) {
 		case T_CloseBracket: return "CLOSED_BRACKET";
 		case T_Comma: return "COMMA";
 		case T_Colon: return "COLON";
+		case T_Dot: return "DOT";
 		case T_StatementEnd: return "STMT_END" + t.token_value + " (pos: " + to_string(t.tok_pos) + ")";
 		case T_EndLine: return "ENDLINE";
 		case T_EOF: return "EOF";
@@ -42,6 +43,7 @@ string representToken(Token t) {
 		case T_Greater: return "GREATER THAN";
 		case T_Less: return "LESS THAN";
 		case T_EQ: return "EQUALS";
+		case T_Not: return "NOT";
 		case T_NONE: return "NONE";
 		default: return "UNKOWN TOKEN: " + t.token_value;
 	}
@@ -83,8 +85,24 @@ void representAST(ASTNode* root) {
 	}
 	//list node
 	if(root->type == N_List) {
-		string str = stringVector(root->listVal);
-		cout << "LIST:{" << str << "}";
+		cout << "LIST:{";
+		for(int i=0; i<root->elements.size(); i++) {
+			if(i != 0)
+				cout << ", ";
+			representAST(root->elements[i]);
+		}
+		cout << "}";
+		return;
+	}
+	//builtin call node
+	if(root->type == N_Call) {
+		cout << "CALL:{" << root->nodeVal << '(';
+		for(int i=0; i<root->elements.size(); i++) {
+			if(i != 0)
+				cout << ", ";
+			representAST(root->elements[i]);
+		}
+		cout << ")}";
 		return;
 	}
 	//list access node
@@ -13,13 +13,43 @@ enum NodeType {
 	N_Var, N_Number, 
 	N_List, N_ListAcc, N_List_Splice,
 	N_Print1, N_Print2, N_StrLtr,
+	N_Call,
 	N_ifStmt, N_BoolExpr,
+	N_While, N_For, N_Block,
 	N_NILNode
 };
 
 //DataTypes enum
 enum DataType {INT, LIST, STR_LITERAL, LIST_ACC, D_NIL};
 
+struct Builtin; //builtins.h
+
+//a statement (or the condition of a loop or if) the interpreter runs as one
+//operation instead of walking its nodes, set by fuseSuperinstructions(); the
+//nodes stay as they are, and the interpreter walks them after all whenever
+//the fused operation doesn't apply, e.g. to raise an error
+enum FusedOp {
+	F_None,
+	F_IncVar, //x = x + k or x = k + x, k an int literal or variable
+	F_ListElemAdd, //l[i] = l[i] + k or l[i] = k + l[i], i and k int literals or variables
+	F_BranchLt, F_BranchGt, F_BranchLe, F_BranchGe, F_BranchEq, F_BranchNe //while or if on a < b etc., a and b int literals or variables
+};
+
+//64 bit FNV-1a of an identifier; var nodes cache it (nameHash), so the
+//interpreter never hashes a name to look a variable up
+inline size_t hashName(const char* name, size_t len) {
+	size_t hash = 14695981039346656037ULL;
+	for(size_t i=0; i<len; i++) {
+		hash ^= (unsigned char)name[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+inline size_t hashName(const string &name) {
+	return hashName(name.data(), name.size());
+}
+
 //Abstract Syntax Tree class
 class ASTNode {
 	public:
@@ -45,10 +75,22 @@ class ASTNode {
 		
 		/*====values====*/
 		string nodeVal; //for number node or string literal node
-		vector<string> listVal; //for list node
+		size_t nameHash; //hashName(nodeVal), for var node
+		long long numVal; //value of a number node
+		vector<ASTNode*> elements; //for list node (number or var nodes, resolved at runtime), call arguments and block bodies
+		const Builtin* builtin; //for call node, resolved by the parser
 		DataType dataType; //for data types
 		/*==end values==*/
 		
+		unsigned stackDepth; //for the root of a statement, slots of the value stack evaluating it needs
+		FusedOp fused; //for statements and loop or if headers
+		DataType provenType; //for +, [], list slices and prints: the operand type inferTypes() proved, D_NIL if it is checked at run time
+		int invariantSlot; //for an expression hoistLoopInvariants() found invariant in a loop: where its value is kept, -1 for none
+		int firstInvariant, numInvariants; //for a loop: the slots of the invariants hoisted to it
+		int boundsSlot; //for a list access eliminateBoundsChecks() proved in bounds while its slot is set: the slot, -1 for none
+		int firstBoundsSlot; //for a counted loop: the slot of the first of boundedLists
+		vector<ASTNode*> boundedLists; //for a counted loop: a variable node of each list its body indexes with the loop's index unchecked
+		
 		/*"constructors"*/
 		
 		//set node type
@@ -59,13 +101,26 @@ class ASTNode {
 			//init
 			left = nullptr;
 			right = nullptr;
+			child = nullptr;
 			nodeVal = "";
+			numVal = 0;
+			nameHash = 0;
 			dataType = D_NIL;
+			stackDepth = 0;
+			fused = F_None;
+			provenType = D_NIL;
+			invariantSlot = -1;
+			firstInvariant = 0;
+			numInvariants = 0;
+			boundsSlot = -1;
+			firstBoundsSlot = 0;
+			builtin = nullptr;
 		}
 		
 		//var node
 		void init_varNode(string varName, DataType inType, ASTNode* inNode) {
 			nodeVal = varName;
+			nameHash = hashName(varName);
 			dataType = inType; //data type
 			child = inNode; //variable value
 			
@@ -73,16 +128,17 @@ class ASTNode {
 			right = nullptr; //not using
 		}
 		//number node
-		void init_numNode(string inVal) {
+		void init_numNode(string inVal, long long val) {
 			nodeVal = inVal;
+			numVal = val;
 			
 			child = nullptr; //not using
 			left = nullptr; //not using
 			right = nullptr; //not using
 		}
 		//list node
-		void init_listNode(vector<string> inLst) {
-			listVal = inLst;
+		void init_listNode(vector<ASTNode*> inElems) {
+			elements = inElems;
 			
 			child = nullptr; //not using
 			left = nullptr; //not using
@@ -139,12 +195,47 @@ class ASTNode {
 			
 			child = nullptr; //not using
 		}
-		//if statement node
-		void init_ifStmtNode(ASTNode* boolExprNode) {
+		//if statement node, the else branch (a block node) is set once it is parsed
+		void init_ifStmtNode(ASTNode* boolExprNode, vector<ASTNode*> body) {
 			child = boolExprNode;
+			elements = body;
+			
+			left = nullptr; //not using
+			right = nullptr; //else branch
+		}
+		//while node
+		void init_whileNode(ASTNode* condNode, vector<ASTNode*> body) {
+			child = condNode;
+			elements = body;
+			
+			left = nullptr; //not using
+			right = nullptr; //not using
+		}
+		//for node
+		void init_forNode(ASTNode* loopVarNode, ASTNode* iterableNode, vector<ASTNode*> body) {
+			left = loopVarNode;
+			right = iterableNode;
+			elements = body;
+			
+			child = nullptr; //not using
+		}
+		//statements run in order
+		void init_blockNode(vector<ASTNode*> stmts) {
+			elements = stmts;
 			
 			left = nullptr; //not using
 			right = nullptr; //not using
+			child = nullptr; //not using
+		}
+		//builtin call node, a method's receiver is its first argument
+		void init_callNode(string name, const Builtin* fn, vector<ASTNode*> args) {
+			nodeVal = name;
+			builtin = fn;
+			elements = args;
+			
+			left = nullptr; //not using
+			right = nullptr; //not using
+			child = nullptr; //not using
 		}
 		//bool expr node
 		void init_boolExprNode(ASTNode* leftOp, string comparator, ASTNode* rightOp) {
@@ -156,32 +247,115 @@ class ASTNode {
 		}
 };
 
+//most values the interpreter's stack holds at once while evaluating node: an
+//operand stays on it while the operands after it are evaluated, and each
+//statement of a block or loop body leaves nothing behind
+unsigned computeStackDepth(ASTNode* node) {
+	if(node == nullptr)
+		return 0;
+	if(node->type == N_List)
+		return 1; //its elements are read where they are stored, never pushed
+	bool body = node->type == N_Block || node->type == N_While || node->type == N_For || node->type == N_ifStmt;
+	
+	vector<ASTNode*> operands = node->elements;
+	operands.push_back(node->left);
+	operands.push_back(node->right);
+	operands.push_back(node->child);
+	
+	unsigned depth = 1;
+	unsigned below = 0; //operands evaluated before this one, still on the stack
+	for(ASTNode* operand: operands) {
+		if(operand == nullptr)
+			continue;
+		depth = max(depth, computeStackDepth(operand) + (body ? 0 : below));
+		below++;
+	}
+	return depth;
+}
+
+/*====superinstructions====*/
+//an int literal or a variable, whose value the interpreter reads without evaluating a node
+bool isAtom(ASTNode* node) {
+	return node != nullptr && (node->type == N_Number || node->type == N_Var);
+}
+
+bool sameAtom(ASTNode* a, ASTNode* b) {
+	if(a->type != b->type)
+		return false;
+	return (a->type == N_Number) ? a->numVal == b->numVal : a->nodeVal == b->nodeVal;
+}
+
+//the operand of sum that isn't same (the addend of x = x + k), nullptr if neither is
+ASTNode* addendOf(ASTNode* sum, ASTNode* same) {
+	if(sum->type != N_Plus || !isAtom(sum->left) || !isAtom(sum->right))
+		return nullptr;
+	if(sameAtom(sum->left, same))
+		return sum->right;
+	if(sameAtom(sum->right, same))
+		return sum->left;
+	return nullptr;
+}
+
+//acc reads the element target writes: the same list, at the same index
+bool isSameElement(ASTNode* acc, ASTNode* target) {
+	return acc->type == N_ListAcc && acc->left->nodeVal == target->left->nodeVal && isAtom(acc->right) && sameAtom(acc->right, target->right);
+}
+
+FusedOp branchOf(const string &cmp) {
+	if(cmp == "<") return F_BranchLt;
+	if(cmp == ">") return F_BranchGt;
+	if(cmp == "<=") return F_BranchLe;
+	if(cmp == ">=") return F_BranchGe;
+	if(cmp == "==") return F_BranchEq;
+	return F_BranchNe;
+}
+
+//marks the statements of tree (and of the blocks in it) that have a fused
+//operation; the parser runs it on every tree it completes
+void fuseSuperinstructions(ASTNode* tree) {
+	if(tree == nullptr)
+		return;
+	
+	if(tree->type == N_Assign && tree->left->type == N_Var && addendOf(tree->right, tree->left) != nullptr) {
+		tree->fused = F_IncVar;
+	}
+	if(tree->type == N_Assign && tree->left->type == N_ListAcc && isAtom(tree->left->right) && tree->right->type == N_Plus) {
+		ASTNode* sum = tree->right;
+		if((isSameElement(sum->left, tree->left) && isAtom(sum->right)) || (isSameElement(sum->right, tree->left) && isAtom(sum->left)))
+			tree->fused = F_ListElemAdd;
+	}
+	if(tree->type == N_While || tree->type == N_ifStmt) {
+		ASTNode* cond = tree->child;
+		if(cond->type == N_BoolExpr && isAtom(cond->left) && isAtom(cond->right))
+			tree->fused = branchOf(cond->nodeVal);
+	}
+	
+	if(tree->type == N_While || tree->type == N_ifStmt || tree->type == N_For || tree->type == N_Block) {
+		for(ASTNode* stmt: tree->elements)
+			fuseSuperinstructions(stmt);
+	}
+	if(tree->type == N_ifStmt) {
+		fuseSuperinstructions(tree->right); //else block
+	}
+}
+/*==end superinstructions==*/
+
 //delete AST method
 //idk if this is the best way to delete this tree or not
 void deleteAST(ASTNode* &root) {
 	if(root == nullptr)
 		return;
 	
-	if(root->left == root->right) {
-		deleteAST(root->left);
-		root->right = nullptr;
-		deleteAST(root->child);
-		return;
-	}
-	
-	if(root->left == root->child) {
-		deleteAST(root->left);
-		root->child = nullptr;
-		deleteAST(root->right);
-		return;
+	for(ASTNode* &elem: root->elements) {
+		deleteAST(elem);
 	}
+	root->elements.clear();
 	
-	if(root->right == root->child) {
-		deleteAST(root->right);
+	//a child two fields share is freed once
+	if(root->right == root->left)
+		root->right = nullptr;
+	if(root->child == root->left || root->child == root->right)
 		root->child = nullptr;
-		deleteAST(root->left);
-		return;
-	}
 	
 	deleteAST(root->left);
 	deleteAST(root->right);
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+
+#include "libminipython.h"
+
+using namespace std;
+
+//per-call overhead of running a one-line script through the embedding API,
+//resetting the context between calls
+int main(int argc, char *argv[]) {
+	int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+	string source = "x = 1 + 2\n";
+	string output;
+	
+	MiniPython interpreter;
+	interpreter.setOutputBuffer(&output);
+	
+	//warm up
+	for(int i=0; i<1000; i++) {
+		interpreter.runSource(source);
+		interpreter.reset();
+	}
+	
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for(int i=0; i<iterations; i++) {
+		interpreter.runSource(source);
+		interpreter.reset();
+	}
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	
+	double totalNs = chrono::duration<double, nano>(end - start).count();
+	cout << "run one-line script + reset: " << totalNs / iterations << " ns/call (" << iterations << " calls)" << endl;
+	
+	//same, but tearing the context down instead of resetting it
+	start = chrono::steady_clock::now();
+	for(int i=0; i<iterations; i++) {
+		MiniPython fresh;
+		fresh.setOutputBuffer(&output);
+		fresh.runSource(source);
+	}
+	end = chrono::steady_clock::now();
+	
+	totalNs = chrono::duration<double, nano>(end - start).count();
+	cout << "new context + run one-line script: " << totalNs / iterations << " ns/call (" << iterations << " calls)" << endl;
+	return 0;
+}
\ No newline at end of file
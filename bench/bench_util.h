@@ -0,0 +1,75 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+//timing shared by the loop benchmarks: one run of a loop can be 10-30% off
+//on a busy machine, so every run is repeated and reported by its median and
+//its minimum (the least disturbed run), and two variants being compared are
+//run alternately so drift affects both alike
+
+struct Timing {
+	double median; //ns per iteration
+	double min;
+};
+
+//ns per iteration of one call of run, which runs iterations iterations
+template<class Run>
+double timeOnce(Run run, long long iterations) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	run();
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return chrono::duration<double, nano>(end - start).count() / iterations;
+}
+
+Timing summarize(vector<double> samples) {
+	sort(samples.begin(), samples.end());
+	size_t mid = samples.size() / 2;
+	double median = (samples.size() % 2 == 1) ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2;
+	return {median, samples.front()};
+}
+
+//a and b timed repeats times each, alternately, after one warm up run of each
+template<class RunA, class RunB>
+void timePair(RunA a, RunB b, long long iterations, int repeats, Timing &ta, Timing &tb) {
+	a();
+	b();
+	vector<double> samplesA, samplesB;
+	for(int r=0; r<repeats; r++) {
+		samplesA.push_back(timeOnce(a, iterations));
+		samplesB.push_back(timeOnce(b, iterations));
+	}
+	ta = summarize(samplesA);
+	tb = summarize(samplesB);
+}
+
+//"median ns/iteration (min ...)"
+string describe(Timing t) {
+	return to_string(t.median) + " ns/iteration (min " + to_string(t.min) + ")";
+}
+
+//how much faster fast is than slow, by the medians and by the minimums
+string speedup(Timing slow, Timing fast) {
+	return to_string(slow.median / fast.median) + "x faster (" + to_string(slow.min / fast.min) + "x by min)";
+}
+
+//the extra time with relative to without, in percent, by the medians and by the minimums
+string overhead(Timing without, Timing with) {
+	return to_string(100 * (with.median / without.median - 1)) + "% overhead (" + to_string(100 * (with.min / without.min - 1)) + "% by min)";
+}
+
+//name, then the two timings and the speedup of the second
+void reportComparison(const string &name, const string &slowLabel, Timing slow, const string &fastLabel, Timing fast) {
+	size_t width = max(slowLabel.size(), fastLabel.size()) + 1;
+	cout << name << endl;
+	cout << "  " << slowLabel << ":" << string(width - slowLabel.size(), ' ') << describe(slow) << endl;
+	cout << "  " << fastLabel << ":" << string(width - fastLabel.size(), ' ') << describe(fast) << ", " << speedup(slow, fast) << endl;
+}
+
+#endif
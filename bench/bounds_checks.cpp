@@ -0,0 +1,34 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "optimizer_bench.h"
+
+using namespace std;
+
+//counted loops indexing a list with their index, run with and without
+//eliminateBoundsChecks(): ns per iteration
+
+//the loop runs over a list of n elements, runs times
+void compare(const string &name, const string &loop, long long n, long long runs, int repeats) {
+	string source = "l = range(" + to_string(n) + ")\ns = 0\nr = 0\nwhile r < " + to_string(runs) + ":\n";
+	istringstream lines(loop);
+	string line;
+	while(getline(lines, line))
+		source += "    " + line + "\n";
+	source += "    r = r + 1\n";
+	comparePasses(name, source, n * runs, repeats, "checked", PASS_HOIST, "unchecked", PASS_BOUNDS);
+}
+
+int main(int argc, char *argv[]) {
+	long long runs = (argc > 1) ? atoll(argv[1]) : 1000;
+	int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+	long long n = 1000;
+	
+	cout << "median and min of " << repeats << " runs" << endl;
+	compare("for i in range(len(l)): s = s + l[i]", "for i in range(len(l)):\n    s = s + l[i]", n, runs, repeats);
+	compare("for i in range(len(l)): l[i] = l[i] + 1", "for i in range(len(l)):\n    l[i] = l[i] + 1", n, runs, repeats);
+	compare("for i in range(len(l)): l[i] = i", "for i in range(len(l)):\n    l[i] = i", n, runs, repeats);
+	compare("while i < len(l): t = l[i], i = i + 1", "i = 0\nwhile i < len(l):\n    t = l[i]\n    i = i + 1", n, runs, repeats);
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#include "lexer.h"
+#include "parser.h"
+#include "ast.h"
+#include "global_scope.h"
+#include "interpreter.h"
+
+using namespace std;
+
+//cost of the interpreter's hot paths in isolation, each over growing input
+//sizes: ns and heap allocations per operation, and how the time scales with
+//the size (the exponent k of n^k between the smallest and largest size), so
+//a path that should be O(1) or O(n) but isn't stands out
+
+/*====allocation counting====*/
+//every form of global new and delete is replaced, so nothing pairs a counted
+//new with the library's delete; they're kept out of line, or gcc inlines the
+//free() into callers it sees allocate with the builtin new and warns about a
+//mismatched pair (-Wmismatched-new-delete)
+static size_t allocations = 0;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+	allocations++;
+	void* p = malloc(size == 0 ? 1 : size);
+	if(p == nullptr)
+		throw bad_alloc();
+	return p;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+	free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+	free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept {
+	free(p);
+}
+/*==end allocation counting==*/
+
+/*====harness====*/
+struct Sample {
+	size_t n;
+	double ns; //per operation
+	double allocs; //per operation
+};
+
+//runs op (which does count operations) until it has taken at least minMs
+template<class Op>
+Sample measure(size_t n, size_t count, Op op, double minMs=20) {
+	op(); //warm up
+	size_t reps = 1;
+	while(true) {
+		size_t allocsBefore = allocations;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(size_t i=0; i<reps; i++)
+			op();
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		double ms = chrono::duration<double, milli>(end - start).count();
+		if(ms >= minMs || reps >= (1u << 30)) {
+			double ops = (double)reps * count;
+			return {n, ms * 1e6 / ops, (allocations - allocsBefore) / ops};
+		}
+		reps *= 2;
+	}
+}
+
+void report(const string &name, const vector<Sample> &samples) {
+	cout << name << endl;
+	for(const Sample &s: samples) {
+		cout << "  n=" << s.n;
+		cout << string(8 - min<size_t>(7, to_string(s.n).size()), ' ');
+		cout << s.ns << " ns/op, " << s.allocs << " allocs/op" << endl;
+	}
+	const Sample &first = samples.front();
+	const Sample &last = samples.back();
+	double k = log(last.ns / first.ns) / log((double)last.n / first.n);
+	string shape = (k < 0.3) ? "constant" : (k < 1.3) ? "linear" : (k < 1.7) ? "superlinear" : "quadratic or worse";
+	cout << "  scaling: n^" << round(k * 100) / 100 << " (" << shape << ")" << endl;
+}
+
+vector<Token> lexLine(const string &line) {
+	LexicalAnalyzer lexer;
+	lexer.initialize(line, 1);
+	lexer.tokenize();
+	lexer.addEndStmntTokenIfNecessary(true);
+	return lexer.getTokens();
+}
+
+ASTNode* compileLine(const string &line) {
+	Parser parse;
+	parse.initialize(lexLine(line));
+	parse.parseAndCreateAST();
+	return parse.getAST();
+}
+
+//"v + v + ... + v", n terms
+string sumOf(size_t n) {
+	string src = "v";
+	for(size_t i=1; i<n; i++)
+		src += " + v";
+	return src;
+}
+
+//"[0, 1, ..., k-1]"
+string listOf(size_t k) {
+	string src = "[";
+	for(size_t i=0; i<k; i++)
+		src += (i == 0 ? "" : ", ") + to_string(i);
+	return src + "]";
+}
+/*==end harness==*/
+
+/*====components====*/
+//Parser::expr (or Parser::getList) on tokens, or deleteAST on what it
+//returns; trees are built and freed in batches, outside the timed part when
+//timing the other
+Sample measureParse(size_t n, const vector<Token> &tokens, bool isList, bool timeDelete) {
+	Parser parse;
+	double ns = 0;
+	size_t allocs = 0;
+	size_t ops = 0;
+	vector<ASTNode*> trees(16);
+	while(ns < 20e6) {
+		size_t allocsBefore = allocations;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(ASTNode* &t: trees) {
+			parse.initialize(tokens);
+			t = isList ? parse.getList() : parse.expr();
+		}
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		if(!timeDelete) {
+			ns += chrono::duration<double, nano>(end - start).count();
+			allocs += allocations - allocsBefore;
+		}
+		
+		allocsBefore = allocations;
+		start = chrono::steady_clock::now();
+		for(ASTNode* &t: trees)
+			deleteAST(t);
+		end = chrono::steady_clock::now();
+		if(timeDelete) {
+			ns += chrono::duration<double, nano>(end - start).count();
+			allocs += allocations - allocsBefore;
+		}
+		ops += trees.size();
+	}
+	return {n, ns / ops, (double)allocs / ops};
+}
+
+//runs line as a statement in ctx, over and over
+Sample evalSample(InterpreterContext &ctx, size_t n, const string &line) {
+	ASTNode* tree = compileLine(line);
+	Interpreter interpret(ctx);
+	Sample s = measure(n, 1, [&] { interpret.execute(tree); });
+	deleteAST(tree);
+	return s;
+}
+
+//binds l to a list of k elements
+void setupList(InterpreterContext &ctx, size_t k) {
+	ASTNode* tree = compileLine("l = range(" + to_string(k) + ")");
+	Interpreter interpret(ctx);
+	interpret.execute(tree);
+	deleteAST(tree);
+}
+/*==end components==*/
+
+int main(int argc, char *argv[]) {
+	size_t maxN = (argc > 1) ? atoi(argv[1]) : 4096;
+	vector<size_t> sizes;
+	for(size_t n=1; n<=maxN; n*=4)
+		sizes.push_back(n);
+	
+	ostringstream discard;
+	InterpreterContext ctx;
+	ctx.out = &discard;
+	ASTNode* setup = compileLine("v = 1");
+	Interpreter(ctx).execute(setup);
+	deleteAST(setup);
+	
+	vector<Sample> lex, expr, list, del;
+	for(size_t n: sizes) {
+		string line = "x = " + sumOf(n);
+		lex.push_back(measure(n, 1, [&] {
+			LexicalAnalyzer lexer;
+			lexer.initialize(line, 1);
+			lexer.tokenize();
+		}));
+		
+		vector<Token> sumTokens = lexLine(sumOf(n));
+		expr.push_back(measureParse(n, sumTokens, false, false));
+		del.push_back(measureParse(n, sumTokens, false, true));
+		list.push_back(measureParse(n, lexLine(listOf(n)), true, false));
+	}
+	report("LexicalAnalyzer::tokenize, x = v + ... + v (n terms)", lex);
+	report("Parser::expr, v + ... + v (n terms)", expr);
+	report("Parser::getList, [0, ..., n-1]", list);
+	report("deleteAST, v + ... + v (n terms)", del);
+	
+	vector<Sample> plusInt, plusList, listAcc, assignList, storeElem, print;
+	for(size_t n: sizes) {
+		plusInt.push_back(evalSample(ctx, n, "x = " + sumOf(n)));
+		setupList(ctx, n);
+		plusList.push_back(evalSample(ctx, n, "x = l + l"));
+		listAcc.push_back(evalSample(ctx, n, "x = l[" + to_string(n / 2) + "]"));
+		assignList.push_back(evalSample(ctx, n, "y = l"));
+		storeElem.push_back(evalSample(ctx, n, "l[" + to_string(n / 2) + "] = 7"));
+		print.push_back(evalSample(ctx, n, "print(l)"));
+		discard.str("");
+	}
+	report("CodeEval N_Plus, x = v + ... + v (n terms)", plusInt);
+	report("CodeEval N_Plus, x = l + l (n elements)", plusList);
+	report("CodeEval N_ListAcc, x = l[i] (n elements)", listAcc);
+	report("CodeEval N_Assign, y = l (n elements)", assignList);
+	report("CodeEval N_Assign, l[i] = 7 (n elements)", storeElem);
+	report("stringVector, print(l) (n elements)", print);
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+
+#include "libminipython.h"
+#include "bench_util.h"
+
+using namespace std;
+
+//cost of one loop iteration: for over a lazy range() against the equivalent
+//while loop, which evaluates its condition and increment as expressions, and
+//each without and with a step limit and a timeout (set too high to be
+//reached), timed alternately over repeated runs
+
+//runs source in interpreter, with limits when limited
+void runLoop(MiniPython &interpreter, const string &source, bool limited, long long iterations) {
+	MiniPythonLimits limits;
+	if(limited) {
+		limits.maxSteps = 4 * iterations;
+		limits.timeoutMs = 24 * 3600 * 1000;
+	}
+	interpreter.setLimits(limits);
+	if(interpreter.runSource(source) != 0)
+		cerr << interpreter.lastError() << endl;
+	interpreter.reset();
+}
+
+int main(int argc, char *argv[]) {
+	long long iterations = (argc > 1) ? atoll(argv[1]) : 100000000;
+	int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+	string n = to_string(iterations);
+	string forSource = "for i in range(" + n + "):\n    x = i\n";
+	string whileSource = "i = 0\nwhile i < " + n + ":\n    x = i\n    i = i + 1\n";
+	string output;
+	
+	MiniPython interpreter;
+	interpreter.setOutputBuffer(&output);
+	
+	Timing forNs, forLimitedNs, whileNs, whileLimitedNs;
+	timePair([&] { runLoop(interpreter, forSource, false, iterations); }, [&] { runLoop(interpreter, forSource, true, iterations); }, iterations, repeats, forNs, forLimitedNs);
+	timePair([&] { runLoop(interpreter, whileSource, false, iterations); }, [&] { runLoop(interpreter, whileSource, true, iterations); }, iterations, repeats, whileNs, whileLimitedNs);
+	
+	cout << iterations << " iterations, median and min of " << repeats << " runs" << endl;
+	cout << "for i in range(n): " << describe(forNs) << endl;
+	cout << "while i < n: " << describe(whileNs) << endl;
+	cout << "for, with --max-steps and --timeout: " << describe(forLimitedNs) << ", " << overhead(forNs, forLimitedNs) << endl;
+	cout << "while, with --max-steps and --timeout: " << describe(whileLimitedNs) << ", " << overhead(whileNs, whileLimitedNs) << endl;
+	return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "lexer.h"
+
+using namespace std;
+
+//lexer throughput in MB/s over a synthetic corpus, for every scan level the cpu supports
+vector<string> makeCorpus(size_t targetBytes) {
+	vector<string> lines;
+	size_t total = 0;
+	int i = 0;
+	while(total < targetBytes) {
+		string line;
+		switch(i % 6) {
+			case 0: line = "counter" + to_string(i) + " = counter" + to_string(i) + " + 12345 + listX[3]"; break;
+			case 1: line = "listY = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]"; break;
+			case 2: line = "# " + string(120, 'c') + " a long comment line"; break;
+			case 3: line = "print(\"" + string(90, 's') + " some output label\", counter)"; break;
+			case 4: line = string(48, ' ') + "value = value + 1" + string(40, ' '); break;
+			case 5: line = "\t\tresult = listX[1:]      # trailing comment"; break;
+		}
+		total += line.size() + 1;
+		lines.push_back(line);
+		i++;
+	}
+	return lines;
+}
+
+double lexCorpus(vector<string> &lines, size_t &tokenCount) {
+	LexicalAnalyzer lexer;
+	tokenCount = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for(size_t i=0; i<lines.size(); i++) {
+		lexer.initialize(lines[i], i+1);
+		lexer.tokenize();
+		tokenCount += lexer.getTokens().size();
+	}
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char *argv[]) {
+	size_t megabytes = (argc > 1) ? atoi(argv[1]) : 64;
+	vector<string> lines = makeCorpus(megabytes << 20);
+	size_t bytes = 0;
+	for(string &l: lines)
+		bytes += l.size() + 1;
+	
+	const char* names[] = {"scalar", "sse2", "avx2"};
+	ScanLevel best = scanLevel;
+	for(int level=SCAN_SCALAR; level<=best; level++) {
+		scanLevel = (ScanLevel)level;
+		size_t tokenCount;
+		lexCorpus(lines, tokenCount); //warm up
+		double secs = lexCorpus(lines, tokenCount);
+		cout << "lexer (" << names[level] << "): " << (bytes / 1048576.0) / secs << " MB/s, "
+			 << tokenCount / secs / 1e6 << " M tokens/s (" << lines.size() << " lines)" << endl;
+	}
+	scanLevel = best;
+	return 0;
+}
\ No newline at end of file
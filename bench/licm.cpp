@@ -0,0 +1,34 @@
+#include <iostream>
+#include <string>
+
+#include "optimizer_bench.h"
+
+using namespace std;
+
+//nested while loops whose inner body recomputes expressions of variables
+//neither loop writes, run with and without hoistLoopInvariants(): ns per
+//inner iteration
+
+//outer times an inner loop of inner iterations running body
+void compare(const string &name, const string &setup, const string &innerCond, const string &body, long long outer, long long inner, int repeats) {
+	string source = setup + "i = 0\nwhile i < " + to_string(outer) + ":\n";
+	source += "    j = 0\n    while " + innerCond + ":\n";
+	source += "        " + body + "\n        j = j + 1\n";
+	source += "    i = i + 1\n";
+	comparePasses(name, source, outer * inner, repeats, "recomputed", PASS_TYPES, "hoisted", PASS_HOIST);
+}
+
+int main(int argc, char *argv[]) {
+	long long outer = (argc > 1) ? atoll(argv[1]) : 1000;
+	int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+	long long inner = 1000;
+	string n = to_string(inner);
+	string list = "l = range(" + n + ")\n";
+	
+	cout << "median and min of " << repeats << " runs" << endl;
+	compare("constant list reads: t = l[3] + l[7]", list, "j < " + n, "t = l[3] + l[7]", outer, inner, repeats);
+	compare("sum of untouched globals: t = a + b + c", "a = 1\nb = 2\nc = 3\n", "j < " + n, "t = a + b + c", outer, inner, repeats);
+	compare("length of an unmodified list: while j < len(l)", list, "j < len(l)", "t = j", outer, inner, repeats);
+	compare("sum of an unmodified list: t = sum(l)", list, "j < " + n, "t = sum(l)", outer / 10 + 1, inner, repeats);
+	return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef OPTIMIZER_BENCH_H
+#define OPTIMIZER_BENCH_H
+
+#include <sstream>
+#include <string>
+
+#include "program.h"
+#include "optimizer.h"
+#include "bench_util.h"
+
+using namespace std;
+
+//shared by the benchmarks of one optimizer pass: the same source compiled
+//through the passes before it, and through it too, each timed over repeated,
+//alternating runs
+
+//the passes of optimizeProgram(), in the order it runs them
+enum OptimizerPass {
+	PASS_TYPES, //eliminateDeadStores() and inferTypes()
+	PASS_HOIST, //then hoistLoopInvariants()
+	PASS_BOUNDS //then eliminateBoundsChecks()
+};
+
+//source compiled and optimized up to and including last, keeping its stores
+//to globals (keepGlobals)
+CompiledProgram* compileThrough(const string &source, OptimizerPass last) {
+	istringstream in(source);
+	CompiledProgram* program = compileProgram(in);
+	eliminateDeadStores(*program, true, false);
+	inferTypes(*program);
+	if(last >= PASS_HOIST)
+		hoistLoopInvariants(*program);
+	if(last >= PASS_BOUNDS)
+		eliminateBoundsChecks(*program);
+	return program;
+}
+
+//name, then source run iterations times compiled through without and through with
+void comparePasses(const string &name, const string &source, long long iterations, int repeats,
+		const string &withoutLabel, OptimizerPass without, const string &withLabel, OptimizerPass with) {
+	CompiledProgram* slow = compileThrough(source, without);
+	CompiledProgram* fast = compileThrough(source, with);
+	InterpreterContext slowCtx, fastCtx;
+	
+	Timing slowNs, fastNs;
+	timePair([&] { executeProgram(*slow, slowCtx); slowCtx.reset(); }, [&] { executeProgram(*fast, fastCtx); fastCtx.reset(); }, iterations, repeats, slowNs, fastNs);
+	delete slow;
+	delete fast;
+	reportComparison(name, withoutLabel, slowNs, withLabel, fastNs);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "reduce.h"
+#include "program.h"
+
+using namespace std;
+
+//throughput in GB/s of the reductions behind sum(), min(), max(), any() and
+//all() over a list of ints, for every scan level the cpu supports and growing
+//thread counts, and of sum(l) against the same sum written as a loop in a script
+
+//bytes of the list read per second by op, run until it has taken 200ms
+template<class Op>
+double gbPerSecond(size_t count, Op op) {
+	op(); //warm up
+	size_t reps = 0;
+	double secs = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	while(secs < 0.2) {
+		op();
+		reps++;
+		secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	}
+	return reps * count * sizeof(long long) / secs / 1e9;
+}
+
+//seconds a script takes to run
+double runSeconds(const string &source) {
+	istringstream in(source);
+	CompiledProgram* program = compileProgram(in);
+	InterpreterContext ctx;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	executeProgram(*program, ctx);
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	delete program;
+	return chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char *argv[]) {
+	size_t count = (argc > 1) ? atoll(argv[1]) : (1 << 24);
+	vector<long long> nums(count);
+	for(size_t i=0; i<count; i++)
+		nums[i] = (long long)(i * 2654435761u % 1000003) + 1; //no zeros, so all() reads every element
+	const long long* data = nums.data();
+	volatile long long sink = 0;
+	
+	cout << count << " ints (" << count * sizeof(long long) / 1048576 << " MB)" << endl;
+	const char* levelNames[] = {"scalar", "sse2", "avx2"};
+	ScanLevel bestLevel = scanLevel;
+	unsigned maxThreads = max(1u, reduceThreads.load());
+	for(int level=SCAN_SCALAR; level<=bestLevel; level++) {
+		if(level == SCAN_SSE2)
+			continue; //the reductions have no sse2 kernels
+		scanLevel = (ScanLevel)level;
+		for(unsigned threads=1; threads<=maxThreads; threads*=2) {
+			reduceThreads.store(threads);
+			cout << levelNames[level] << ", " << threads << " thread(s):" << endl;
+			cout << "  sum: " << gbPerSecond(count, [&] { sink = (long long)reduceSum(data, count); }) << " GB/s" << endl;
+			cout << "  min: " << gbPerSecond(count, [&] { sink = reduceMin(data, count); }) << " GB/s" << endl;
+			cout << "  max: " << gbPerSecond(count, [&] { sink = reduceMax(data, count); }) << " GB/s" << endl;
+			cout << "  all: " << gbPerSecond(count, [&] { sink = reduceAll(data, count); }) << " GB/s" << endl;
+		}
+	}
+	scanLevel = bestLevel;
+	reduceThreads.store(maxThreads);
+	
+	//building the script's list is timed on its own and taken off
+	size_t scriptCount = min<size_t>(count, 1 << 20);
+	string setup = "l = range(" + to_string(scriptCount) + ")\n";
+	double base = runSeconds(setup);
+	double builtin = (runSeconds(setup + "r = 0\nwhile r < 100:\n    s = sum(l)\n    r = r + 1\n") - base) / 100; //not optimized, so the sum isn't hoisted
+	double loop = runSeconds(setup + "s = 0\ni = 0\nwhile i < len(l):\n    s = s + l[i]\n    i = i + 1\n") - base;
+	double bytes = scriptCount * sizeof(long long);
+	cout << "script over " << scriptCount << " ints:" << endl;
+	cout << "  s = sum(l):             " << bytes / builtin / 1e9 << " GB/s" << endl;
+	cout << "  while loop adding l[i]: " << bytes / loop / 1e9 << " GB/s (" << loop / builtin << "x slower)" << endl;
+	return 0;
+}
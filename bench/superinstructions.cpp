@@ -0,0 +1,81 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "program.h"
+#include "bench_util.h"
+
+using namespace std;
+
+//the loop shapes the parser fuses (x = x + k, l[i] = l[i] + k, and a while or
+//if on a comparison of ints), run as superinstructions and with the fusing
+//undone: ns per iteration, and in builds with opcode counting (make
+//OPCODE_STATS=1, whose timings include the counting) how many nodes the
+//interpreter dispatches on per iteration
+
+//undoes fuseSuperinstructions()
+void unfuse(ASTNode* node) {
+	if(node == nullptr)
+		return;
+	node->fused = F_None;
+	for(ASTNode* elem: node->elements)
+		unfuse(elem);
+	unfuse(node->left);
+	unfuse(node->right);
+	unfuse(node->child);
+}
+
+//runs program once in ctx
+void run(CompiledProgram &program, InterpreterContext &ctx) {
+	executeProgram(program, ctx);
+	ctx.reset();
+}
+
+#ifdef OPCODE_STATS
+//runs program once in ctx, and returns how many nodes it evaluated
+unsigned long long runCounted(CompiledProgram &program, InterpreterContext &ctx) {
+	unsigned long long before = ctx.opcodeStats.totalNodes();
+	run(program, ctx);
+	return ctx.opcodeStats.totalNodes() - before;
+}
+#endif
+
+void compare(const string &name, const string &source, long long iterations, int repeats) {
+	istringstream fusedIn(source), walkedIn(source);
+	CompiledProgram* fused = compileProgram(fusedIn);
+	CompiledProgram* walked = compileProgram(walkedIn);
+	for(ASTNode* stmt: walked->statements)
+		unfuse(stmt);
+	InterpreterContext fusedCtx, walkedCtx;
+	
+#ifdef OPCODE_STATS
+	double fusedPerIteration = (double)runCounted(*fused, fusedCtx) / iterations;
+	double walkedPerIteration = (double)runCounted(*walked, walkedCtx) / iterations;
+#endif
+	
+	Timing walkedNs, fusedNs;
+	timePair([&] { run(*walked, walkedCtx); }, [&] { run(*fused, fusedCtx); }, iterations, repeats, walkedNs, fusedNs);
+	delete fused;
+	delete walked;
+	
+	reportComparison(name, "walked", walkedNs, "fused", fusedNs);
+#ifdef OPCODE_STATS
+	cout << "  dispatches/iteration: walked " << walkedPerIteration << ", fused " << fusedPerIteration << endl;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+	long long iterations = (argc > 1) ? atoll(argv[1]) : 10000000;
+	int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+	string n = to_string(iterations);
+	
+	cout << iterations << " iterations, median and min of " << repeats << " runs" << endl;
+#ifndef OPCODE_STATS
+	cout << "(dispatches per iteration need a build with opcode counting: make clean && make OPCODE_STATS=1 bench)" << endl;
+#endif
+	compare("while i < n: i = i + 1", "i = 0\nwhile i < " + n + ":\n    i = i + 1\n", iterations, repeats);
+	compare("while i < n: s = s + i, i = i + 1", "s = 0\ni = 0\nwhile i < " + n + ":\n    s = s + i\n    i = i + 1\n", iterations, repeats);
+	compare("while i < n: l[2] = l[2] + 3, i = i + 1", "l = [0, 0, 0, 0]\ni = 0\nwhile i < " + n + ":\n    l[2] = l[2] + 3\n    i = i + 1\n", iterations, repeats);
+	compare("while i < n: if i != 5: c = c + 1, i = i + 1", "c = 0\ni = 0\nwhile i < " + n + ":\n    if i != 5:\n        c = c + 1\n    i = i + 1\n", iterations, repeats);
+	return 0;
+}
@@ -0,0 +1,201 @@
+#ifndef BUILTINS_H
+#define BUILTINS_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "global_scope.h"
+#include "list_view.h"
+#include "reduce.h"
+
+using namespace std;
+
+//natively implemented builtins; the parser resolves a call to its Builtin
+//entry, so the interpreter calls fn directly without looking the name up
+
+//arguments of one call, already evaluated
+struct BuiltinCall {
+	const Value* args; //on the interpreter's stack
+	size_t numArgs;
+	ListView* target; //storage of the receiver, for methods (they may modify it)
+	InterpreterContext &ctx; //owns the lists a builtin returns
+};
+
+//sets result (D_NIL for none) and returns "", or returns the runtime error text
+typedef string (*BuiltinFn)(BuiltinCall &call, Value &result);
+
+enum BuiltinStyle {
+	B_FUNCTION, //name(args)
+	B_METHOD //list.name(args), called on a list variable
+};
+
+struct Builtin {
+	const char* name;
+	BuiltinStyle style;
+	int minArgs;
+	int maxArgs; //-1 for any number
+	BuiltinFn fn;
+	DataType result; //type of the result if the call succeeds, D_NIL for none
+};
+
+/*====helpers====*/
+void setInt(Value &result, long long val) {
+	result.dat = INT;
+	result.num = val;
+}
+
+string typeName(DataType type) {
+	return (type == LIST) ? "list" : "int";
+}
+
+//the numbers min()/max() compare: the elements of a single list argument, read
+//where the list stores them, or the arguments, copied to scratch
+string collectNumbers(BuiltinCall &call, const string &fnName, vector<long long> &scratch, const long long* &nums, size_t &count) {
+	if(call.numArgs == 1 && call.args[0].dat == LIST) {
+		nums = call.args[0].list->begin();
+		count = call.args[0].list->size();
+	} else {
+		for(size_t i=0; i<call.numArgs; i++) {
+			if(call.args[i].dat != INT)
+				return ", " + fnName + "() arguments must be ints or a single list";
+			scratch.push_back(call.args[i].num);
+		}
+		nums = scratch.data();
+		count = scratch.size();
+	}
+	if(count == 0)
+		return ", " + fnName + "() arg is an empty sequence";
+	return "";
+}
+/*==end helpers==*/
+
+/*====builtins====*/
+//len(list), O(1)
+string builtinLen(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != LIST)
+		return ", object of type '" + typeName(call.args[0].dat) + "' has no len()";
+	setInt(result, call.args[0].list->size());
+	return "";
+}
+
+//list.append(int), amortized O(1) when nothing else shares the list
+string builtinAppend(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != INT)
+		return ", this interpreter does not handle 2d lists";
+	call.target->push_back(call.args[0].num);
+	result.dat = D_NIL;
+	return "";
+}
+
+//sum(list), exact: only a total that doesn't fit an int is an overflow
+string builtinSum(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != LIST)
+		return ", '" + typeName(call.args[0].dat) + "' object is not iterable";
+	const ListView* lst = call.args[0].list;
+	__int128 total = reduceSum(lst->begin(), lst->size());
+	if(total != (long long)total)
+		return ", integer overflow";
+	setInt(result, (long long)total);
+	return "";
+}
+
+//min(list) or min(a, b, ...)
+string builtinMin(BuiltinCall &call, Value &result) {
+	vector<long long> scratch;
+	const long long* nums = nullptr;
+	size_t count = 0;
+	string err = collectNumbers(call, "min", scratch, nums, count);
+	if(err != "")
+		return err;
+	setInt(result, reduceMin(nums, count));
+	return "";
+}
+
+//max(list) or max(a, b, ...)
+string builtinMax(BuiltinCall &call, Value &result) {
+	vector<long long> scratch;
+	const long long* nums = nullptr;
+	size_t count = 0;
+	string err = collectNumbers(call, "max", scratch, nums, count);
+	if(err != "")
+		return err;
+	setInt(result, reduceMax(nums, count));
+	return "";
+}
+
+//any(list), 1 if an element is nonzero, else 0
+string builtinAny(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != LIST)
+		return ", '" + typeName(call.args[0].dat) + "' object is not iterable";
+	setInt(result, reduceAny(call.args[0].list->begin(), call.args[0].list->size()));
+	return "";
+}
+
+//all(list), 1 if no element is 0 (also for an empty list), else 0
+string builtinAll(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != LIST)
+		return ", '" + typeName(call.args[0].dat) + "' object is not iterable";
+	setInt(result, reduceAll(call.args[0].list->begin(), call.args[0].list->size()));
+	return "";
+}
+
+//abs(int)
+string builtinAbs(BuiltinCall &call, Value &result) {
+	if(call.args[0].dat != INT)
+		return ", bad operand type for abs(): '" + typeName(call.args[0].dat) + "'";
+	long long val = call.args[0].num;
+	setInt(result, (val < 0) ? -val : val);
+	return "";
+}
+
+//range(stop), range(start, stop) or range(start, stop, step), as a list
+string builtinRange(BuiltinCall &call, Value &result) {
+	long long bounds[3] = {0, 0, 1}; //start, stop, step
+	for(size_t i=0; i<call.numArgs; i++) {
+		if(call.args[i].dat != INT)
+			return ", range() arguments must be ints";
+	}
+	if(call.numArgs == 1) {
+		bounds[1] = call.args[0].num;
+	} else {
+		for(size_t i=0; i<call.numArgs; i++)
+			bounds[i] = call.args[i].num;
+	}
+	if(bounds[2] == 0)
+		return ", range() arg 3 must not be zero";
+	
+	ListView elems(&call.ctx.memory);
+	//a step past the largest (or smallest) int ends the range, like passing stop
+	for(long long i=bounds[0]; (bounds[2] > 0) ? i < bounds[1] : i > bounds[1];) {
+		elems.push_back(i);
+		if(__builtin_add_overflow(i, bounds[2], &i))
+			break;
+	}
+	result.dat = LIST;
+	result.list = call.ctx.tempList(move(elems));
+	return "";
+}
+/*==end builtins==*/
+
+const Builtin builtinTable[] = {
+	{"len", B_FUNCTION, 1, 1, builtinLen, INT},
+	{"append", B_METHOD, 1, 1, builtinAppend, D_NIL},
+	{"sum", B_FUNCTION, 1, 1, builtinSum, INT},
+	{"min", B_FUNCTION, 1, -1, builtinMin, INT},
+	{"max", B_FUNCTION, 1, -1, builtinMax, INT},
+	{"any", B_FUNCTION, 1, 1, builtinAny, INT},
+	{"all", B_FUNCTION, 1, 1, builtinAll, INT},
+	{"abs", B_FUNCTION, 1, 1, builtinAbs, INT},
+	{"range", B_FUNCTION, 1, 3, builtinRange, LIST}
+};
+
+//the builtin called name, nullptr if there is none
+const Builtin* lookupBuiltin(const string &name) {
+	for(const Builtin &b: builtinTable) {
+		if(name == b.name)
+			return &b;
+	}
+	return nullptr;
+}
+
+#endif
\ No newline at end of file
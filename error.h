@@ -2,41 +2,51 @@
 #define ERROR_H
 
 #include <iostream>
+#include <string>
 using namespace std;
 
 enum ErrType {
 	InvalidCharacterError,
 	InvalidSyntaxError,
 	RunTimeError,
+	MemoryError,
 	DefaultError
 };
 
 struct CreateProgramError : public exception {
+	string errMsg; //formatted error text, printed before what()
+	
+	CreateProgramError(string inMsg="") {
+		errMsg = inMsg;
+	}
+	
 	const char * what() const throw () {
 		return "Error encountered, program stopped.";
 	}
 };
 
+//the message is carried by the exception instead of printed here, so errors
+//raised on the pipeline threads can be reported in source order by the executor
 void RaiseError(ErrType err, string txt, int lineNum) {
 	switch(err) {
 		case InvalidCharacterError: {
-			cout << "InvalidCharacterError --> \'" << txt << "\' at line " << lineNum << ". ";
-			throw CreateProgramError();
+			throw CreateProgramError("InvalidCharacterError --> \'" + txt + "\' at line " + to_string(lineNum) + ". ");
 		}
 		
 		case InvalidSyntaxError: {
-			cout << "InvalidSyntaxError at line " << lineNum << ", expected " << txt << ". ";
-			throw CreateProgramError();
+			throw CreateProgramError("InvalidSyntaxError at line " + to_string(lineNum) + ", expected " + txt + ". ");
 		}
 		
 		case RunTimeError: {
-			cout << "RunTimeError at line " << lineNum << txt << ". ";
-			throw CreateProgramError();
+			throw CreateProgramError("RunTimeError at line " + to_string(lineNum) + txt + ". ");
+		}
+		
+		case MemoryError: {
+			throw CreateProgramError("MemoryError at line " + to_string(lineNum) + txt + ". ");
 		}
 		
 		default: {
-			cout << "Error at line " << lineNum << " --> " << txt << ". ";
-			throw CreateProgramError();
+			throw CreateProgramError("Error at line " + to_string(lineNum) + " --> " + txt + ". ");
 		}
 	}
 }
@@ -2,22 +2,277 @@
 #define GLOBAL_SCOPE_H
 
 #include <iostream>
-#include <map>
 #include <utility>
-#include <stack>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <type_traits>
+#include <atomic>
+#include <climits>
 #include "ast.h"
+#include "list_view.h"
+#include "symbol_table.h"
+#include "memory_budget.h"
+#include "opcode_stats.h"
 
 using namespace std;
 
-struct evalHolder {
+//a value being evaluated; ints are held inline, lists and string literals are
+//referenced where they are stored (a variable, a node, or the temporaries of
+//the statement being run), so values are copied with a memcpy
+struct Value {
 	DataType dat;
-	string val;
-	vector<string> listVal;
+	union {
+		long long num; //INT
+		const ListView* list; //LIST
+		const string* str; //STR_LITERAL
+	};
 };
+static_assert(is_trivially_copyable<Value>::value, "values are copied as raw bytes");
 
-//global
-stack<evalHolder> evalTracker;
-map<string, pair<string, DataType>> symbolTable; //name, <value, dataType>
-map<string, vector<string>> listSymbolTable; //name, vector<string>
+//operand stack of the interpreter: one array, sized before a tree runs from
+//the depth the parser computed for it (ASTNode::stackDepth), so pushing never
+//allocates or checks for room, and emptying it is O(1)
+class ValueStack {
+	private:
+		vector<Value> slots;
+		size_t depth = 0;
+	
+	public:
+		//makes room for n values, charged to budget; only grows the array
+		void reserve(size_t n, MemoryBudget &budget) {
+			if(slots.size() < n) {
+				budget.charge(A_Frame, (n - slots.size()) * sizeof(Value));
+				slots.resize(n);
+			}
+		}
+		void push(const Value &v) {
+			slots[depth++] = v;
+		}
+		Value& top() {
+			return slots[depth - 1];
+		}
+		//the value at position i from the bottom, and the ones above it
+		const Value* at(size_t i) const {
+			return slots.data() + i;
+		}
+		void pop() {
+			depth--;
+		}
+		size_t size() const {
+			return depth;
+		}
+		bool empty() const {
+			return depth == 0;
+		}
+		//drops every value above the first n
+		void truncate(size_t n) {
+			depth = n;
+		}
+		void clear() {
+			depth = 0;
+		}
+};
+
+//last result of a pure expression and the versions of the variables it read
+struct MemoEntry {
+	bool valid = false; //value holds a result
+	unsigned generation = 0; //generation it was cached in
+	vector<string> inputNames; //variables the expression reads
+	vector<pair<SymbolEntry*, unsigned long>> inputs; //their entries and versions when cached
+	Value value;
+	ListView listVal; //elements of a LIST value, which points here
+};
+
+//entry a node's expression shares with every expression that spells the same
+struct MemoNode {
+	unsigned long epoch;
+	MemoEntry* entry; //nullptr if the expression isn't pure or the cache was full
+};
+
+//value of a loop invariant expression (always an int) for the current run of its loop
+struct InvariantValue {
+	bool valid = false;
+	long long num = 0;
+};
+
+//limits of one run of a script, 0 for none
+struct ScriptLimits {
+	size_t maxMemory = 0; //bytes, see MemoryBudget
+	unsigned long long maxSteps = 0; //loop iterations
+	unsigned long timeoutMs = 0; //wall clock
+};
+
+//loop iterations (back edges) a run has taken, against its step limit and
+//deadline. The interpreter only decrements countdown each iteration; the
+//limits are looked at when it runs out, so a timer thread setting timedOut is
+//noticed within checkInterval iterations
+struct StepCounter {
+	static const long long checkInterval = 4096;
+	long long countdown = LLONG_MAX; //iterations left before the next check
+	unsigned long long granted = LLONG_MAX; //iterations handed to countdown so far
+	atomic<bool> timedOut{false};
+	
+	unsigned long long steps() const {
+		return granted - countdown;
+	}
+	
+	//starts counting a run with these limits
+	void start(const ScriptLimits &limits) {
+		granted = 0;
+		countdown = 0;
+		timedOut.store(false);
+		refill(limits);
+	}
+	
+	//hands countdown the iterations up to the next check
+	void refill(const ScriptLimits &limits) {
+		unsigned long long taken = steps();
+		unsigned long long grant = LLONG_MAX;
+		if(limits.timeoutMs != 0)
+			grant = checkInterval;
+		if(limits.maxSteps != 0)
+			grant = min(grant, limits.maxSteps - min(taken, limits.maxSteps));
+		countdown = grant;
+		granted = taken + grant;
+	}
+};
+
+//state of one running script (its "global scope"), one per run so several
+//scripts can execute in the same process without sharing anything
+struct InterpreterContext {
+	MemoryBudget memory; //first, so the lists and stack charged to it are freed before it
+	ValueStack evalTracker;
+	deque<ListView> tempLists; //lists built by the statement being run
+	SymbolTable symbolTable; //every global, ints and lists alike
+	unsigned generation = 1;
+	ostream* out = &cout; //where print() writes
+	unsigned long writeClock = 0;
+	
+	//memoization of pure expressions, keyed by their text so repeated expressions
+	//share an entry; nodes are resolved to entries once per run (memoEpoch), as
+	//trees of an earlier run may have been freed and their addresses reused
+	unordered_map<string, MemoEntry> memo;
+	unordered_map<const ASTNode*, MemoNode> memoNodes;
+	size_t memoCapacity = 0; //most expressions cached, 0 turns memoization off
+	unsigned long memoEpoch = 1;
+	unsigned long memoLookups = 0;
+	unsigned long memoHits = 0;
+	
+	ScriptLimits limits;
+	StepCounter steps;
+	
+	//values of the loop invariants of the program being run, each valid from
+	//the first time it is evaluated until its loop starts again
+	vector<InvariantValue> invariants;
+	
+	//for each list a counted loop indexes with its index: whether the index
+	//stays within the list for the current run of the loop
+	vector<char> inBounds;
+	
+#ifdef OPCODE_STATS
+	OpcodeStats opcodeStats; //every run's, for --opcode-stats
+#endif
+	
+	void setLimits(const ScriptLimits &inLimits) {
+		limits = inLimits;
+		memory.limit = limits.maxMemory;
+	}
+	
+	//returns the entry of a variable, nullptr if not defined; hash is hashName(name)
+	SymbolEntry* findSymbol(const string &name, size_t hash) {
+		SymbolEntry* entry = symbolTable.find(name, hash);
+		if(entry == nullptr || entry->generation != generation)
+			return nullptr;
+		return entry;
+	}
+	
+	SymbolEntry* findSymbol(const string &name) {
+		return findSymbol(name, hashName(name));
+	}
+	
+	//returns the storage of a list variable, nullptr if not defined or not a list
+	ListView* findList(const string &name, size_t hash) {
+		SymbolEntry* entry = findSymbol(name, hash);
+		if(entry == nullptr || entry->type != LIST)
+			return nullptr;
+		return &entry->list;
+	}
+	
+	void setSymbol(const string &name, size_t hash, long long value, DataType type) {
+		SymbolEntry* entry = symbolTable.insert(name, hash);
+		if(entry->type == LIST && type != LIST) {
+			entry->list = ListView(); //frees the elements unless something else shares them
+		}
+		entry->type = type;
+		entry->num = value;
+		entry->generation = generation;
+		entry->version = ++writeClock;
+	}
+	
+	//entry of name, created if needed, for storing to it repeatedly without looking it up again
+	SymbolEntry* symbolSlot(const string &name, size_t hash) {
+		return symbolTable.insert(name, hash);
+	}
+	
+	//stores an int to an entry from symbolSlot
+	void storeInt(SymbolEntry* entry, long long value) {
+		if(entry->type == LIST) {
+			entry->list = ListView();
+		}
+		entry->type = INT;
+		entry->num = value;
+		entry->generation = generation;
+		entry->version = ++writeClock;
+	}
+	
+	//records an in place write to a list, so memoized reads of it go stale
+	void markWritten(const string &name, size_t hash) {
+		SymbolEntry* entry = symbolTable.find(name, hash);
+		if(entry != nullptr)
+			entry->version = ++writeClock;
+	}
+	
+	//binds name to lst's elements without copying them
+	void setList(const string &name, size_t hash, const ListView &lst) {
+		SymbolEntry* entry = symbolTable.insert(name, hash);
+		entry->type = LIST;
+		entry->num = 0;
+		entry->list = lst;
+		entry->generation = generation;
+		entry->version = ++writeClock;
+	}
+	
+	//a list built while running a statement, alive until the next statement
+	//starts (see releaseTemps)
+	const ListView* tempList(ListView &&lst) {
+		tempLists.push_back(move(lst));
+		return &tempLists.back();
+	}
+	
+	//frees the lists built since tempLists had n of them
+	void releaseTemps(size_t n = 0) {
+		while(tempLists.size() > n) {
+			tempLists.pop_back();
+		}
+	}
+	
+	//forgets every variable; the table nodes stay allocated and are reused
+	//when the next run binds the same names. O(1) unless lists are still
+	//alive, whose elements are freed so the next run starts with its whole budget
+	void reset() {
+		generation++;
+		memoEpoch++;
+		evalTracker.clear();
+		releaseTemps();
+		if(memory.used[A_List] != 0) {
+			symbolTable.clearLists();
+			for(pair<const string, MemoEntry> &m: memo) {
+				m.second.valid = false;
+				m.second.listVal = ListView();
+			}
+		}
+	}
+};
 
 #endif
\ No newline at end of file
@@ -5,35 +5,140 @@
 #include <vector>
 #include <map>
 #include <utility>
-#include <stack>
+#include <charconv>
 #include "ast.h"
 #include "global_scope.h"
+#include "builtins.h"
 #include "error.h"
 
 class Interpreter {
 	private:
+		InterpreterContext &ctx; //state of the script being run
 		ASTNode* root;
 		vector<ASTNode*> codeBlock;
 		bool blockFlag = false;
+		bool memoize = false; //trees outlive the run, so nodes may be mapped to cache entries
+		bool inMemoEval = false; //evaluating the operands of a memoized expression
+		
+		//text of a pure expression, adding the variables it reads to names; false if it isn't pure
+		bool memoKey(ASTNode* node, string &key, vector<string> &names) {
+			if(node->type == N_Number) {
+				key += node->nodeVal;
+				return true;
+			}
+			if(node->type == N_Var) {
+				key += node->nodeVal;
+				for(string &n: names) {
+					if(n == node->nodeVal)
+						return true;
+				}
+				names.push_back(node->nodeVal);
+				return true;
+			}
+			if(node->type == N_ListAcc) {
+				bool pure = memoKey(node->left, key, names);
+				key += '[';
+				pure = pure && memoKey(node->right, key, names);
+				key += ']';
+				return pure;
+			}
+			if(node->type == N_Plus) {
+				key += '(';
+				bool pure = memoKey(node->left, key, names);
+				key += '+';
+				pure = pure && memoKey(node->right, key, names);
+				key += ')';
+				return pure;
+			}
+			return false;
+		}
+		
+		//cache entry of node's expression, nullptr if it can't be cached
+		MemoEntry* memoEntry(ASTNode* node) {
+			unordered_map<const ASTNode*, MemoNode>::iterator it = ctx.memoNodes.find(node);
+			if(it != ctx.memoNodes.end() && it->second.epoch == ctx.memoEpoch)
+				return it->second.entry;
+			
+			if(ctx.memoNodes.size() >= 4 * ctx.memoCapacity)
+				ctx.memoNodes.clear();
+			MemoNode &resolved = ctx.memoNodes[node];
+			resolved.epoch = ctx.memoEpoch;
+			resolved.entry = nullptr;
+			
+			string key;
+			vector<string> names;
+			if(!memoKey(node, key, names))
+				return nullptr;
+			unordered_map<string, MemoEntry>::iterator entryIt = ctx.memo.find(key);
+			if(entryIt == ctx.memo.end()) {
+				if(ctx.memo.size() >= ctx.memoCapacity)
+					return nullptr;
+				entryIt = ctx.memo.insert(make_pair(key, MemoEntry())).first;
+				entryIt->second.inputNames = names;
+			}
+			resolved.entry = &entryIt->second;
+			return resolved.entry;
+		}
+		
+		//pushes the cached value if none of the expression's inputs were written since
+		bool memoLookup(MemoEntry* entry) {
+			ctx.memoLookups++;
+			if(!entry->valid || entry->generation != ctx.generation)
+				return false;
+			for(pair<SymbolEntry*, unsigned long> &input: entry->inputs) {
+				if(input.first->version != input.second)
+					return false;
+			}
+			ctx.memoHits++;
+			ctx.evalTracker.push(entry->value);
+			return true;
+		}
+		
+		//caches the value just computed (top of evalTracker)
+		void memoStore(MemoEntry* entry) {
+			entry->inputs.clear();
+			for(string &name: entry->inputNames) {
+				SymbolEntry* sym = ctx.symbolTable.insert(name, hashName(name)); //defined, the expression just read it
+				entry->inputs.push_back(make_pair(sym, sym->version));
+			}
+			entry->value = ctx.evalTracker.top();
+			if(entry->value.dat == LIST) {
+				//the list the value points to is freed with the statement
+				entry->listVal = *entry->value.list;
+				entry->value.list = &entry->listVal;
+			}
+			entry->generation = ctx.generation;
+			entry->valid = true;
+		}
 		
 	public:
+		Interpreter(InterpreterContext &inCtx) : ctx(inCtx) {
+			root = nullptr;
+		}
+		
 		//initialization method (for one tree)
 		void initialize(ASTNode* tree) {
 			emptyEvalTracker();
+			reserveStack(tree);
 			root = tree;
 			blockFlag = false;
+			memoize = false;
 		}
 		
 		//initialization method (for block of code)
 		void initialize(vector<ASTNode*> block) {
 			emptyEvalTracker();
+			for(ASTNode* n: block) {
+				reserveStack(n);
+			}
 			codeBlock = block;
 			root = nullptr;
 			blockFlag = true;
+			memoize = false;
 		}
 		
 		//error
-		void raiseRunTimeError(string errorMsg, int lineNumber) {
+		void raiseRunTimeError(string errorMsg, int lineNumber, ErrType err=RunTimeError) {
 			if(!blockFlag) {
 				deleteAST(root);
 			} else if(blockFlag) {
@@ -42,118 +147,419 @@ class Interpreter {
 				}
 			}
 			
-			RaiseError(RunTimeError, errorMsg, lineNumber);
+			RaiseError(err, errorMsg, lineNumber);
+		}
+		
+		//an allocation the memory budget refused, while running lineNumber: its
+		//size, and what the script already held when it was made
+		void raiseMemoryError(const MemoryLimitExceeded &e, int lineNumber) {
+			size_t inUse = e.used[A_List] + e.used[A_String] + e.used[A_Frame];
+			string errMsg = ", allocating " + to_string(e.bytes) + " bytes for a " + allocClassName(e.allocClass) + " with " + to_string(inUse) + " bytes in use (lists " + to_string(e.used[A_List]) + ", strings " + to_string(e.used[A_String]) + ", frames " + to_string(e.used[A_Frame]) + ") exceeds the memory limit of " + to_string(ctx.memory.limit) + " bytes";
+			raiseRunTimeError(errMsg, lineNumber, MemoryError);
+		}
+		
+		//storage of the list a var node names, without copying it; nullptr if it
+		//holds an int, raises the same errors as evaluating the var otherwise
+		ListView* findListOperand(ASTNode* varNode) {
+			SymbolEntry* var = ctx.findSymbol(varNode->nodeVal, varNode->nameHash);
+			if(var == nullptr) {
+				string errMsg = ", \'" + varNode->nodeVal + "\' is not defined";
+				raiseRunTimeError(errMsg, varNode->lineNum);
+			}
+			if(var->type != LIST)
+				return nullptr;
+			return &var->list;
+		}
+		
+		//value of a list index (int literal or variable)
+		long long listIndex(ASTNode* idxNode, int lineNumber) {
+			Value lstIdx = evalValue(idxNode);
+			if(lstIdx.dat != INT) {
+				raiseRunTimeError(", could not execute code for list access", lineNumber);
+			}
+			return lstIdx.num;
+		}
+		
+		//evaluates node and takes its value off the stack; a list value stays
+		//valid until the statement ends
+		Value evalValue(ASTNode* node) {
+			CodeEval(node);
+			Value val = ctx.evalTracker.top();
+			ctx.evalTracker.pop();
+			return val;
+		}
+		
+		void pushInt(long long num) {
+			Value val;
+			val.dat = INT;
+			val.num = num;
+			ctx.evalTracker.push(val);
+		}
+		
+		void pushList(const ListView* lst) {
+			Value val;
+			val.dat = LIST;
+			val.list = lst;
+			ctx.evalTracker.push(val);
+		}
+		
+		//runs statements in order; they leave nothing on evalTracker, even calls
+		//whose result is unused, so a loop's stack doesn't grow with its
+		//iterations, and the lists each one built are freed after it
+		void runStatements(const vector<ASTNode*> &stmts) {
+			for(ASTNode* stmt: stmts) {
+				size_t depth = ctx.evalTracker.size();
+				size_t temps = ctx.tempLists.size();
+				try {
+					CodeEval(stmt);
+				} catch(MemoryLimitExceeded &e) {
+					raiseMemoryError(e, stmt->lineNum);
+				}
+				ctx.evalTracker.truncate(depth);
+				ctx.releaseTemps(temps);
+			}
+		}
+		
+		//a loop going around again: counts a step, and looks at the limits only
+		//once the steps handed to the countdown are used up
+		void loopStep(int lineNumber) {
+			if(--ctx.steps.countdown < 0)
+				checkLimits(lineNumber);
+		}
+		
+		//raises the error of a limit the run went over, the step limit first so
+		//a script that hits both stops the same way every time
+		void checkLimits(int lineNumber) {
+			if(ctx.limits.maxSteps != 0 && ctx.steps.steps() > ctx.limits.maxSteps) {
+				ctx.steps.countdown++; //the step refused isn't taken
+				raiseRunTimeError(", exceeded the limit of " + to_string(ctx.limits.maxSteps) + " loop iterations", lineNumber);
+			}
+			if(ctx.steps.timedOut.load()) {
+				raiseRunTimeError(", timed out after " + to_string(ctx.limits.timeoutMs) + " ms", lineNumber);
+			}
+			ctx.steps.refill(ctx.limits);
+		}
+		
+		//value of a node inferTypes() proved to be an int; literals and
+		//variables are read where they are stored, without the stack
+		long long provenInt(ASTNode* node) {
+			if(node->type == N_Number)
+				return node->numVal;
+			if(node->type == N_Var)
+				return ctx.findSymbol(node->nodeVal, node->nameHash)->num;
+			return evalValue(node).num;
 		}
 		
-		//code evaluation
+		//storage of a variable inferTypes() proved to hold a list
+		ListView* provenList(ASTNode* varNode) {
+			return &ctx.findSymbol(varNode->nodeVal, varNode->nameHash)->list;
+		}
+		
+		//whether idx is outside lst, the list acc reads or writes; not checked
+		//if eliminateBoundsChecks() proved it within lst for this run of the loop
+		bool outOfBounds(ASTNode* acc, long long idx, ListView* lst) {
+			if(acc->boundsSlot >= 0 && ctx.inBounds[acc->boundsSlot])
+				return false;
+			return idx < 0 || idx >= (long long)lst->size();
+		}
+		
+		/*====superinstructions====*/
+		//value of an int literal or int variable, read without touching the
+		//stack; false if it isn't one (a fused operation then walks its nodes)
+		bool intOperand(ASTNode* atom, long long &val) {
+			if(atom->type == N_Number) {
+				val = atom->numVal;
+				return true;
+			}
+			SymbolEntry* var = ctx.findSymbol(atom->nodeVal, atom->nameHash);
+			if(var == nullptr || var->type != INT)
+				return false;
+			val = var->num;
+			return true;
+		}
+		
+		//x = x + k as one load, add and store; false if x or k isn't an int or
+		//the sum overflows, to be run as the assignment it is
+		bool incVar(ASTNode* node) {
+			ASTNode* addend = addendOf(node->right, node->left);
+			SymbolEntry* var = ctx.findSymbol(node->left->nodeVal, node->left->nameHash);
+			long long k = 0;
+			long long sum = 0;
+			if(var == nullptr || var->type != INT || !intOperand(addend, k) || __builtin_add_overflow(var->num, k, &sum))
+				return false;
+			ctx.storeInt(var, sum);
+			return true;
+		}
+		
+		//l[i] = l[i] + k, adding to the element where it is stored; false if
+		//anything would raise an error, to be run as the assignment it is
+		bool listElemAdd(ASTNode* node) {
+			ASTNode* target = node->left;
+			ASTNode* sum = node->right;
+			ASTNode* addend = isSameElement(sum->left, target) ? sum->right : sum->left;
+			ListView* lst = ctx.findList(target->left->nodeVal, target->left->nameHash);
+			long long idx = 0;
+			long long k = 0;
+			if(lst == nullptr || !intOperand(target->right, idx) || outOfBounds(target, idx, lst) || !intOperand(addend, k))
+				return false;
+			long long elem = 0;
+			if(__builtin_add_overflow((*lst)[idx], k, &elem))
+				return false;
+			lst->mutableAt(idx) = elem;
+			ctx.markWritten(target->left->nodeVal, target->left->nameHash);
+			return true;
+		}
+		
+		//condition of a while or if, a fused comparison of two ints without
+		//evaluating its nodes
+		bool conditionHolds(ASTNode* header) {
+			long long a = 0;
+			long long b = 0;
+			if(header->fused == F_None || !intOperand(header->child->left, a) || !intOperand(header->child->right, b))
+				return isTrue(header->child);
+			switch(header->fused) {
+				case F_BranchLt: return a < b;
+				case F_BranchGt: return a > b;
+				case F_BranchLe: return a <= b;
+				case F_BranchGe: return a >= b;
+				case F_BranchEq: return a == b;
+				default: return a != b;
+			}
+		}
+		/*==end superinstructions==*/
+		
+		//truth value of a condition: a nonzero int or a nonempty list
+		bool isTrue(ASTNode* cond) {
+			Value val = evalValue(cond);
+			if(val.dat == INT) {
+				return val.num != 0;
+			}
+			if(val.dat == LIST) {
+				return val.list->size() != 0;
+			}
+			raiseRunTimeError(", invalid condition", cond->lineNum);
+			return false;
+		}
+		
+		//for loop over range(): the bounds are evaluated once and the loop variable
+		//is rewritten in place each iteration, no list is built
+		void forRange(ASTNode* node, SymbolEntry* loopVar) {
+			ASTNode* rangeCall = node->right;
+			long long bounds[3] = {0, 0, 1}; //start, stop, step
+			size_t numArgs = rangeCall->elements.size();
+			for(size_t i=0; i<numArgs; i++) {
+				Value arg = evalValue(rangeCall->elements[i]);
+				if(arg.dat != INT) {
+					raiseRunTimeError(", range() arguments must be ints", rangeCall->lineNum);
+				}
+				bounds[(numArgs == 1) ? 1 : i] = arg.num;
+			}
+			if(bounds[2] == 0) {
+				raiseRunTimeError(", range() arg 3 must not be zero", rangeCall->lineNum);
+			}
+			if(!node->boundedLists.empty()) {
+				//the loop takes values in [start, stop) going up, (stop, start] going down
+				bool up = bounds[2] > 0;
+				bool empty = up ? bounds[0] >= bounds[1] : bounds[0] <= bounds[1];
+				if(empty)
+					checkLoopBounds(node, -1, -1);
+				else
+					checkLoopBounds(node, up ? bounds[0] : bounds[1] + 1, up ? bounds[1] - 1 : bounds[0]);
+			}
+			
+			for(long long i=bounds[0]; (bounds[2] > 0) ? i < bounds[1] : i > bounds[1];) {
+				ctx.storeInt(loopVar, i);
+				runStatements(node->elements);
+				loopStep(node->lineNum);
+				if(__builtin_add_overflow(i, bounds[2], &i))
+					break; //the next value is past the largest (or smallest) int, so past stop
+			}
+		}
+		
+		//for loop over a list, reading its elements where they are stored; the
+		//loop holds a view of the list, so it runs over the elements it had when
+		//the loop started even if the body changes the list
+		void forList(ASTNode* node, SymbolEntry* loopVar) {
+			ListView lst;
+			ListView* stored = (node->right->type == N_Var) ? findListOperand(node->right) : nullptr;
+			if(stored != nullptr) {
+				lst = *stored;
+			} else {
+				Value iterable = evalValue(node->right);
+				if(iterable.dat != LIST) {
+					raiseRunTimeError(", '" + typeName(iterable.dat) + "' object is not iterable", node->lineNum);
+				}
+				lst = *iterable.list;
+			}
+			
+			for(long long elem: lst) {
+				ctx.storeInt(loopVar, elem);
+				runStatements(node->elements);
+				loopStep(node->lineNum);
+			}
+		}
+		
+		//a loop starting: the invariants hoisted to it are computed afresh
+		void startLoop(ASTNode* loop) {
+			for(int i=0; i<loop->numInvariants; i++)
+				ctx.invariants[loop->firstInvariant + i].valid = false;
+		}
+		
+		//a counted loop (see eliminateBoundsChecks) starting, its index taking
+		//values in lo..hi: sets whether they are all within each list it indexes
+		void checkLoopBounds(ASTNode* loop, long long lo, long long hi) {
+			for(size_t i=0; i<loop->boundedLists.size(); i++) {
+				ASTNode* var = loop->boundedLists[i];
+				ListView* lst = ctx.findList(var->nodeVal, var->nameHash);
+				ctx.inBounds[loop->firstBoundsSlot + i] = lst != nullptr && lo >= 0 && hi < (long long)lst->size();
+			}
+		}
+		
+		//code evaluation; a loop invariant (see hoistLoopInvariants) is
+		//evaluated the first time its loop's run reaches it and reused after that
 		void CodeEval(ASTNode* node) {
+			if(node == nullptr || node->invariantSlot < 0) {
+				evalNode(node);
+				return;
+			}
+			InvariantValue &invariant = ctx.invariants[node->invariantSlot];
+			if(invariant.valid) {
+				pushInt(invariant.num);
+				return;
+			}
+			evalNode(node);
+			Value val = ctx.evalTracker.top();
+			if(val.dat == INT) {
+				invariant.valid = true;
+				invariant.num = val.num;
+			}
+		}
+		
+		void evalNode(ASTNode* node) {
 			//none
 			if(node == nullptr) {
-				evalHolder temp;
+				Value temp;
 				temp.dat = D_NIL;
-				temp.val = "NULL";
-				evalTracker.push(temp);
+				temp.num = 0;
+				ctx.evalTracker.push(temp);
 				return;
 			}
-			//number node
+#ifdef OPCODE_STATS
+			ctx.opcodeStats.countNode(node->type);
+#endif
+			//number node, parsed once by the parser
 			if(node->type == N_Number) {
-				evalHolder temp;
-				temp.dat = INT;
-				temp.val = node->nodeVal;
-				evalTracker.push(temp);
+				pushInt(node->numVal);
 				return;
 			}
 			//list node
 			if(node->type == N_List) {
-				evalHolder temp;
-				temp.dat = LIST;
-				vector<string> tempLst = node->listVal;
-				temp.listVal = tempLst;
-				evalTracker.push(temp);
+				ListView elems(&ctx.memory);
+				elems.reserve(node->elements.size());
+				for(ASTNode* elem: node->elements) {
+					if(elem->type == N_Number) {
+						elems.push_back(elem->numVal);
+					} else if(SymbolEntry* elemVar = ctx.findSymbol(elem->nodeVal, elem->nameHash)) {
+						if(elemVar->type == INT) {
+							elems.push_back(elemVar->num);
+						} else {
+							//raise invalid type error
+							string errMsg = ", lists may only contain ints or int variables, multiple dimensions are not supported";
+							raiseRunTimeError(errMsg, elem->lineNum);
+						}
+					} else {
+						//raise error
+						string errMsg = ", \'" + elem->nodeVal + "\' not defined";
+						raiseRunTimeError(errMsg, elem->lineNum);
+					}
+				}
+				pushList(ctx.tempList(move(elems)));
 				return;
 			}
 			//string literal node
 			if(node->type == N_StrLtr) {
-				evalHolder temp;
+				Value temp;
 				temp.dat = STR_LITERAL;
-				temp.val = node->nodeVal;
-				evalTracker.push(temp);
+				temp.str = &node->nodeVal;
+				ctx.evalTracker.push(temp);
 				return;
 			}
 			//list access node
+			if(node->type == N_ListAcc && node->provenType == LIST) {
+				//a list and an int index, as proven by inferTypes()
+				ListView* lst = provenList(node->left);
+				long long idx = provenInt(node->right);
+#ifdef OPCODE_STATS
+				ctx.opcodeStats.countOperands(node, LIST, INT);
+#endif
+				if(outOfBounds(node, idx, lst)) {
+					raiseRunTimeError(", index out of bounds", node->lineNum);
+				}
+				pushInt((*lst)[idx]);
+				return;
+			}
 			if(node->type == N_ListAcc) {
-				CodeEval(node->left); //get list name
-				evalHolder lstVar = evalTracker.top();
-				evalTracker.pop();
-				
-				CodeEval(node->right); //get index number
-				evalHolder lstIdx = evalTracker.top();
-				evalTracker.pop();
+				ListView* lst = findListOperand(node->left);
+				long long idx = listIndex(node->right, node->lineNum);
+#ifdef OPCODE_STATS
+				ctx.opcodeStats.countOperands(node, (lst != nullptr) ? LIST : INT, INT);
+#endif
+				if(lst == nullptr) {
+					raiseRunTimeError(", could not execute code for list access", node->lineNum);
+				}
+				if(outOfBounds(node, idx, lst)) {
+					raiseRunTimeError(", index out of bounds", node->lineNum);
+				}
 				
-				if(lstVar.dat == LIST && lstIdx.dat == INT) {
-					evalHolder lstAccVal;
-					lstAccVal.dat = INT;
-					int idx = stoi(lstIdx.val);
-					vector<string> tempVec = lstVar.listVal;
-					
-					if(idx > tempVec.size()) {
+				pushInt((*lst)[idx]);
+				return;
+			}
+			//list splice node
+			if(node->type == N_List_Splice && node->provenType == LIST) {
+				//a list and an int (or no) bound, as proven by inferTypes()
+				ListView* lst = provenList(node->left);
+				long long spliceVal = 0;
+				if(node->right != nullptr) {
+					spliceVal = provenInt(node->right);
+					if(spliceVal < 0 || spliceVal > (long long)lst->size()) {
 						raiseRunTimeError(", index out of bounds", node->lineNum);
 					}
-					
-					string resVal = tempVec[idx];
-					lstAccVal.val = resVal;
-					evalTracker.push(lstAccVal);
-					return;
+				}
+				if(node->nodeVal == "T") {
+					pushList(ctx.tempList(lst->slice(spliceVal)));
 				} else {
-					//raise error
-					raiseRunTimeError(", could not execute code for list access", node->lineNum);
+					pushList(lst);
 				}
+				return;
 			}
-			//list splice node
 			if(node->type == N_List_Splice) {
-				CodeEval(node->left); //get var node
-				evalHolder lstVarName = evalTracker.top();
-				evalTracker.pop();
-				
-				CodeEval(node->right); //get splice number
-				evalHolder spliceValue_str = evalTracker.top();
-				evalTracker.pop();
+				Value lstVarName = evalValue(node->left); //get var node, its list where it is stored
+				Value spliceValue = evalValue(node->right); //get splice number
 				
 				bool isSpliceVal = true;
-				int spliceVal;
-				if(spliceValue_str.dat == INT) {
-					spliceVal = stoi(spliceValue_str.val);
+				long long spliceVal = 0;
+				if(spliceValue.dat == INT) {
+					spliceVal = spliceValue.num;
 					isSpliceVal = true;
-				} else if(spliceValue_str.dat == D_NIL && spliceValue_str.val == "NULL") {
+				} else if(spliceValue.dat == D_NIL) {
 					isSpliceVal = false;
 				} else {
 					//raise error
 					raiseRunTimeError(", invalid type", node->lineNum);
 				}
 				
-				evalHolder returnVal;
-				vector<string> returnList;
-				
+				//the slice is a view sharing the list's buffer, O(1) whatever its length
 				if(lstVarName.dat == LIST) {
-					vector<string> origList = lstVarName.listVal;
-					if(isSpliceVal && (spliceVal > origList.size())) {
+					if(isSpliceVal && (spliceVal < 0 || spliceVal > (long long)lstVarName.list->size())) {
 						//raise error
 						raiseRunTimeError(", index out of bounds", node->lineNum);
 					}
 					
 					if(node->nodeVal == "T") {
-						for(int i=spliceVal; i<origList.size(); i++) {
-							returnList.push_back(origList[i]);
-						}
-						returnVal.dat = LIST;
-						returnVal.listVal = returnList;
-						evalTracker.push(returnVal);
+						pushList(ctx.tempList(lstVarName.list->slice(spliceVal)));
 						return;
 					} else if(node->nodeVal == "F") {
-						returnList = origList;
-						returnVal.dat = LIST;
-						returnVal.listVal = returnList;
-						evalTracker.push(returnVal);
+						ctx.evalTracker.push(lstVarName);
 						return;
 					}
 				} else {
@@ -161,31 +567,61 @@ class Interpreter {
 					raiseRunTimeError(", invalid type", node->lineNum);
 				}
 			}
+			//builtin call node
+			if(node->type == N_Call) {
+				const Builtin* fn = node->builtin;
+				size_t firstArg = 0;
+				ListView* target = nullptr;
+				if(fn->style == B_METHOD) {
+					//the receiver is modified in place, so it is passed as storage, not evaluated
+					target = findListOperand(node->elements[0]);
+					if(target == nullptr) {
+						raiseRunTimeError(", 'int' object has no attribute \'" + node->nodeVal + "\'", node->lineNum);
+					}
+					firstArg = 1;
+				}
+				
+				//the arguments stay on the stack, the builtin reads them there
+				size_t base = ctx.evalTracker.size();
+				size_t temps = ctx.tempLists.size();
+				for(size_t i=firstArg; i<node->elements.size(); i++) {
+					CodeEval(node->elements[i]);
+				}
+				
+				BuiltinCall call = {ctx.evalTracker.at(base), ctx.evalTracker.size() - base, target, ctx};
+				Value result;
+				result.dat = D_NIL;
+				result.num = 0;
+				string errMsg = fn->fn(call, result);
+				if(errMsg != "") {
+					raiseRunTimeError(errMsg, node->lineNum);
+				}
+				if(target != nullptr) {
+					ctx.markWritten(node->elements[0]->nodeVal, node->elements[0]->nameHash);
+				}
+				ctx.evalTracker.truncate(base);
+				if(result.dat != LIST) {
+					//lists built for the arguments go now, so they hold no second
+					//reference to a list the rest of the statement writes
+					ctx.releaseTemps(temps);
+				}
+				ctx.evalTracker.push(result);
+				return;
+			}
 			//var node
 			if(node->type == N_Var) {
-				string varName = node->nodeVal;
-				if(symbolTable.find(varName) != symbolTable.end()) {
-					if(symbolTable[varName].second == LIST) {
-						if(listSymbolTable.find(varName) != listSymbolTable.end()) {
-							//place list data in stack
-							evalHolder temp;
-							temp.dat = LIST;
-							temp.listVal = listSymbolTable[varName];
-							evalTracker.push(temp);
-							return;
-						} else {
-							//raise error
-							string errMsg = ", \'" + varName + "\' is not defined"; 
-							raiseRunTimeError(errMsg, node->lineNum);
-						}
+				const string &varName = node->nodeVal;
+				SymbolEntry* var = ctx.findSymbol(varName, node->nameHash);
+				if(var != nullptr) {
+					if(var->type == LIST) {
+						//place the list in stack, where the variable stores it
+						pushList(&var->list);
+						return;
 					} else {
 						//regular variable
-						if(symbolTable[varName].second == INT) {
+						if(var->type == INT) {
 							//place variable data in stack
-							evalHolder temp;
-							temp.dat = INT;
-							temp.val = symbolTable[varName].first;
-							evalTracker.push(temp);
+							pushInt(var->num);
 							return;
 						} else {
 							//raise error
@@ -204,24 +640,22 @@ class Interpreter {
 			}
 			//assign node
 			if(node->type == N_Assign) {
+				if(node->fused == F_IncVar && incVar(node))
+					return;
+				if(node->fused == F_ListElemAdd && listElemAdd(node))
+					return;
 				//variable
 				if(node->left->type == N_Var) {
-					string varName = node->left->nodeVal;
+					const string &varName = node->left->nodeVal;
 					
-					CodeEval(node->right); //get right value
-					evalHolder varVal = evalTracker.top();
-					evalTracker.pop();
+					Value varVal = evalValue(node->right); //get right value
 					
 					if(varVal.dat == INT) {
-						pair<string, DataType> symTabVarVal(varVal.val, INT);
-						symbolTable[varName] = symTabVarVal;
+						ctx.setSymbol(varName, node->left->nameHash, varVal.num, INT);
 						return;
 						
 					} else if(varVal.dat == LIST) {
-						vector<string> tempLst = varVal.listVal;
-						pair<string, DataType> lstSymTabDat("", LIST);
-						symbolTable[varName] = lstSymTabDat;
-						listSymbolTable[varName] = tempLst;
+						ctx.setList(varName, node->left->nameHash, *varVal.list);
 						return;
 						
 					} else {
@@ -232,96 +666,77 @@ class Interpreter {
 				}
 				//list access
 				else if(node->left->type == N_ListAcc) {
-					string lstVarName = node->left->left->nodeVal;
-					int idxNum = stoi(node->left->right->nodeVal);
-					vector<string> tempLst;
-					
-					//check if list exists
-					if(symbolTable.find(lstVarName) != symbolTable.end()) {
-						if(symbolTable[lstVarName].second == LIST) {
-							if(listSymbolTable.find(lstVarName) != listSymbolTable.end()) {
-								tempLst = listSymbolTable[lstVarName];
-							} else {
-								string errMsg = ", could not fetch \'" + lstVarName + "\' from symbol table";
-								raiseRunTimeError(errMsg, node->lineNum);
-							}
-						} else {
-							//raise error
-							string errMsg = ", \'" + lstVarName + "\' is not defined"; 
-							raiseRunTimeError(errMsg, node->lineNum);
-						}
-					} else {
+					//the element is written in place, the list is never copied
+					const string &lstVarName = node->left->left->nodeVal;
+					size_t lstVarHash = node->left->left->nameHash;
+					ListView* lst = ctx.findList(lstVarName, lstVarHash);
+					if(lst == nullptr) {
 						//raise error
-						string errMsg = ", \'" + lstVarName + "\' is not defined"; 
+						string errMsg = ", \'" + lstVarName + "\' is not defined";
 						raiseRunTimeError(errMsg, node->lineNum);
 					}
 					
 					//check if index is not out of bounds
-					if(idxNum > tempLst.size()) {
+					long long idx = listIndex(node->left->right, node->lineNum);
+					if(outOfBounds(node->left, idx, lst)) {
 						//raise error
 						raiseRunTimeError(", index out of bounds", node->lineNum);
 					}
 					
-					CodeEval(node->right); //get right value
-					evalHolder tempVarVal = evalTracker.top();
-					evalTracker.pop();
+					Value tempVarVal = evalValue(node->right); //get right value, evaluating it binds no names so lst stays valid
 					
 					if(tempVarVal.dat == INT) {
-						tempLst[idxNum] = tempVarVal.val;
-						listSymbolTable[lstVarName] = tempLst;
+						lst->mutableAt(idx) = tempVarVal.num;
+						ctx.markWritten(lstVarName, lstVarHash);
 						return;
 					} else {
 						//raise error, this interpreter does not hanlde 2d lists
 						raiseRunTimeError(", this interpreter does not handle 2d lists", node->lineNum);
 					}
 				}
-				//list splice
+				//list splice, a[i:] = b[j:] makes a a[:i] + b[j:] as in python
 				else if(node->left->type == N_List_Splice) {
-					CodeEval(node->left);
-					evalHolder leftHandSide = evalTracker.top();
-					evalTracker.pop();
+					size_t temps = ctx.tempLists.size();
+					Value leftHandSide = evalValue(node->left); //checks the target is a list and i is in bounds
 					if(leftHandSide.dat != LIST) {
 						//raise error
 						raiseRunTimeError(", invalid types", node->lineNum);
 					}
+					ctx.releaseTemps(temps); //don't hold a second reference to the target's buffer
 					
-					string leftSideVarName = node->left->left->nodeVal;
-					CodeEval(node->left->right);
-					evalHolder s_leftSpliceIdx = evalTracker.top();
-					evalTracker.pop();
-					if(s_leftSpliceIdx.dat != INT) {
-						//raise error
-						raiseRunTimeError(", invalid types", node->lineNum);
+					const string &leftSideVarName = node->left->left->nodeVal;
+					size_t leftSideVarHash = node->left->left->nameHash;
+					long long leftSpliceIdx = 0; //a[:]
+					if(node->left->right != nullptr) {
+						Value s_leftSpliceIdx = evalValue(node->left->right);
+						if(s_leftSpliceIdx.dat != INT) {
+							//raise error
+							raiseRunTimeError(", invalid types", node->lineNum);
+						}
+						leftSpliceIdx = s_leftSpliceIdx.num;
 					}
-					int leftSpliceIdx = stoi(s_leftSpliceIdx.val);
 					
 					if(node->right->type != N_List_Splice) {
 						//raise error
 						raiseRunTimeError(", expected list splice", node->lineNum);
 					}
 					
-					CodeEval(node->right);
-					evalHolder rightHandSide = evalTracker.top();
-					evalTracker.pop();
+					Value rightHandSide = evalValue(node->right);
 					
 					if(rightHandSide.dat != LIST) {
 						//raise error
 						raiseRunTimeError(", invalid types", node->lineNum);
 					}
 					
-					vector<string> origLeftHandVector = listSymbolTable[leftSideVarName];
-					if(leftSpliceIdx > origLeftHandVector.size()) {
+					ListView* lst = ctx.findList(leftSideVarName, leftSideVarHash);
+					if(leftSpliceIdx < 0 || leftSpliceIdx > (long long)lst->size()) {
 						//raise error
 						raiseRunTimeError(", index out of bounds", node->lineNum);
 					}
 					
-					vector<string> leftHandSplicedVector = leftHandSide.listVal;
-					vector<string> rightHandSplicedVector = rightHandSide.listVal;
-					
-					leftHandSplicedVector = rightHandSplicedVector;
-					origLeftHandVector.erase(origLeftHandVector.begin()+(leftSpliceIdx-1), origLeftHandVector.end());
-					origLeftHandVector.insert(origLeftHandVector.end(), leftHandSplicedVector.begin(), leftHandSplicedVector.end());
-					listSymbolTable[leftSideVarName] = origLeftHandVector;
+					//in place unless something else shares the target's elements
+					lst->replaceTail(leftSpliceIdx, *rightHandSide.list);
+					ctx.markWritten(leftSideVarName, leftSideVarHash);
 					return;
 				}
 				//error
@@ -332,80 +747,169 @@ class Interpreter {
 			}
 			//plus node
 			if(node->type == N_Plus) {
-				CodeEval(node->left); //get left operand
-				evalHolder leftOp = evalTracker.top();
-				evalTracker.pop();
+				//only whole expressions are memoized, not their subexpressions
+				MemoEntry* memo = (memoize && !inMemoEval) ? memoEntry(node) : nullptr;
+				if(memo != nullptr) {
+					if(memoLookup(memo))
+						return;
+					inMemoEval = true;
+				}
 				
-				CodeEval(node->right); //get right operand
-				evalHolder rightOp = evalTracker.top();
-				evalTracker.pop();
+				if(node->provenType == INT) {
+					//two ints, as proven by inferTypes()
+					long long a = provenInt(node->left);
+					long long b = provenInt(node->right);
+#ifdef OPCODE_STATS
+					ctx.opcodeStats.countOperands(node, INT, INT);
+#endif
+					long long sum = 0;
+					if(__builtin_add_overflow(a, b, &sum)) {
+						raiseRunTimeError(", integer overflow", node->lineNum);
+					}
+					pushInt(sum);
+					if(memo != nullptr) {
+						inMemoEval = false;
+						memoStore(memo);
+					}
+					return;
+				}
+				
+				Value leftOp = evalValue(node->left); //get left operand
+				Value rightOp = evalValue(node->right); //get right operand
+#ifdef OPCODE_STATS
+				ctx.opcodeStats.countOperands(node, leftOp.dat, rightOp.dat);
+#endif
 				
 				if(leftOp.dat == INT && rightOp.dat == INT) {
 					//do addition
-					int temp1 = stoi(leftOp.val);
-					int temp2 = stoi(rightOp.val);
-					int temp3 = temp1 + temp2;
-					
-					evalHolder addRes;
-					addRes.dat = INT;
-					addRes.val = to_string(temp3);
-					evalTracker.push(addRes);
+					long long sum = 0;
+					if(__builtin_add_overflow(leftOp.num, rightOp.num, &sum)) {
+						raiseRunTimeError(", integer overflow", node->lineNum);
+					}
+					pushInt(sum);
 				} else if(leftOp.dat == LIST && rightOp.dat == LIST) {
-					//concatenate list
-					vector<string> tempLst1 = leftOp.listVal;
-					vector<string> tempLst2 = rightOp.listVal;
-					vector<string> resLst = leftOp.listVal;
-					resLst.insert(resLst.end(), tempLst2.begin(), tempLst2.end());
-					
-					evalHolder concatRes;
-					concatRes.dat = LIST;
-					concatRes.listVal = resLst;
-					evalTracker.push(concatRes);
+					//concatenate list, into one buffer sized (and charged) up front
+					ListView resLst = *leftOp.list;
+					resLst.replaceTail(resLst.size(), *rightOp.list);
+					pushList(ctx.tempList(move(resLst)));
+				} else {
+					//raise type error
+					raiseRunTimeError(", invalid types", node->lineNum);
+				}
+				
+				if(memo != nullptr) {
+					inMemoEval = false;
+					memoStore(memo);
+				}
+				return;
+			}
+			//comparison node, 1 if it holds and 0 if not
+			if(node->type == N_BoolExpr) {
+				Value leftOp = evalValue(node->left); //get left operand
+				Value rightOp = evalValue(node->right); //get right operand
+				
+				const string &cmp = node->nodeVal;
+				bool holds = false;
+				if(leftOp.dat == INT && rightOp.dat == INT) {
+					long long a = leftOp.num;
+					long long b = rightOp.num;
+					if(cmp == "<") holds = a < b;
+					else if(cmp == ">") holds = a > b;
+					else if(cmp == "<=") holds = a <= b;
+					else if(cmp == ">=") holds = a >= b;
+					else if(cmp == "==") holds = a == b;
+					else holds = a != b;
+				} else if(leftOp.dat == LIST && rightOp.dat == LIST && (cmp == "==" || cmp == "!=")) {
+					bool same = leftOp.list->size() == rightOp.list->size() && equal(leftOp.list->begin(), leftOp.list->end(), rightOp.list->begin());
+					holds = (cmp == "==") ? same : !same;
 				} else {
 					//raise type error
 					raiseRunTimeError(", invalid types", node->lineNum);
 				}
 				
+				pushInt(holds ? 1 : 0);
+				return;
+			}
+			//statements run in order
+			if(node->type == N_Block) {
+				runStatements(node->elements);
+				return;
+			}
+			//if node
+			if(node->type == N_ifStmt) {
+				if(conditionHolds(node)) {
+					runStatements(node->elements);
+				} else if(node->right != nullptr) {
+					runStatements(node->right->elements);
+				}
+				return;
+			}
+			//while node
+			if(node->type == N_While) {
+				startLoop(node);
+				if(!node->boundedLists.empty()) {
+					//i < len(l) bounds the index from above every iteration
+					SymbolEntry* idx = ctx.findSymbol(node->child->left->nodeVal, node->child->left->nameHash);
+					checkLoopBounds(node, (idx != nullptr && idx->type == INT) ? idx->num : -1, -1);
+				}
+				while(conditionHolds(node)) {
+					runStatements(node->elements);
+					loopStep(node->lineNum);
+				}
+				return;
+			}
+			//for node
+			if(node->type == N_For) {
+				SymbolEntry* loopVar = ctx.symbolSlot(node->left->nodeVal, node->left->nameHash);
+				startLoop(node);
+				if(node->right->type == N_Call && node->right->builtin->fn == builtinRange) {
+					forRange(node, loopVar);
+				} else {
+					forList(node, loopVar);
+				}
 				return;
 			}
 			//print(one_arg) node
+			if(node->type == N_Print1 && node->provenType == INT) {
+				long long val = provenInt(node->child);
+				*ctx.out << val << endl;
+				return;
+			}
 			if(node->type == N_Print1) {
-				CodeEval(node->child); //visit child
-				evalHolder temp = evalTracker.top(); //get child
+				Value temp = evalValue(node->child); //visit child
 				
 				if(temp.dat == INT) {
-					cout << temp.val << endl;
+					*ctx.out << temp.num << endl;
 				} else if(temp.dat == LIST) {
-					cout << '[' << stringVector(temp.listVal) << ']' << endl;
+					string elems = stringVector(*temp.list); //before writing anything, it may raise a MemoryError
+					*ctx.out << '[' << elems << ']' << endl;
 				}
-				
-				evalTracker.pop();
 				return;
 			}
 			//print(two_args) node
+			if(node->type == N_Print2 && node->provenType == INT && node->left->type == N_StrLtr) {
+				long long val = provenInt(node->right);
+				*ctx.out << node->left->nodeVal << ' ' << val << endl;
+				return;
+			}
 			if(node->type == N_Print2) {
-				CodeEval(node->left); //get string literal
-				evalHolder strLit_val = evalTracker.top();
-				string printStrLit = "";
-				if(strLit_val.dat == STR_LITERAL) {
-					printStrLit = strLit_val.val;
-				} else {
+				Value strLit_val = evalValue(node->left); //get string literal
+				if(strLit_val.dat != STR_LITERAL) {
 					//raise error
 					raiseRunTimeError("not string literal", node->lineNum);
 				}
-				evalTracker.pop();
+				const string &printStrLit = *strLit_val.str;
 				
-				CodeEval(node->right); //get var or int val
-				evalHolder otherVal = evalTracker.top();
+				Value otherVal = evalValue(node->right); //get var or int val
 				if(otherVal.dat == LIST) {
-					cout << printStrLit << ' ';
-					cout << '[' << stringVector(otherVal.listVal) << ']' << endl;
+					string elems = stringVector(*otherVal.list);
+					*ctx.out << printStrLit << ' ';
+					*ctx.out << '[' << elems << ']' << endl;
 				} else {
 					//regular variable
-					cout << printStrLit << ' ';
-					cout << otherVal.val << endl;
+					*ctx.out << printStrLit << ' ';
+					*ctx.out << otherVal.num << endl;
 				}
-				evalTracker.pop();
 				return;
 			}
 			//error
@@ -417,32 +921,86 @@ class Interpreter {
 		//evaluate code or code block
 		void evaluate() {
 			if(!blockFlag) {
-				CodeEval(root);
+				//an empty line has nothing to run
+				if(root != nullptr) {
+					try {
+						CodeEval(root);
+					} catch(MemoryLimitExceeded &e) {
+						raiseMemoryError(e, root->lineNum);
+					}
+				}
 				deleteAST(root);
 			} 
 			
 			else if(blockFlag) {
 				for(ASTNode* node: codeBlock) {
-					CodeEval(node);
+					try {
+						CodeEval(node);
+					} catch(MemoryLimitExceeded &e) {
+						raiseMemoryError(e, node->lineNum);
+					}
 					deleteAST(node);
 				}
 			}
+			emptyEvalTracker();
+		}
+		
+		//evaluate a tree owned by someone else (e.g. a cached CompiledProgram),
+		//it is not deleted afterwards or on error; the tree must stay alive until
+		//the program is done, as nodes are mapped to memoized results
+		void execute(ASTNode* tree) {
+			emptyEvalTracker();
+			root = nullptr;
+			blockFlag = false;
+			memoize = ctx.memoCapacity > 0;
+			inMemoEval = false;
+			if(tree == nullptr)
+				return;
+			reserveStack(tree);
+			try {
+				CodeEval(tree);
+			} catch(MemoryLimitExceeded &e) {
+				raiseMemoryError(e, tree->lineNum);
+			}
+			emptyEvalTracker();
 		}
 		
-		//empty stack
+		//empty stack, O(1), and free the lists the last statement built
 		void emptyEvalTracker() {
-			while(!evalTracker.empty()) {
-				evalTracker.pop();
+			ctx.evalTracker.clear();
+			ctx.releaseTemps();
+		}
+		
+		//makes room on the stack for evaluating tree
+		void reserveStack(ASTNode* tree) {
+			if(tree == nullptr)
+				return;
+			if(tree->stackDepth == 0) {
+				//not built by the parser
+				tree->stackDepth = computeStackDepth(tree);
+			}
+			try {
+				ctx.evalTracker.reserve(tree->stackDepth, ctx.memory);
+			} catch(MemoryLimitExceeded &e) {
+				raiseMemoryError(e, tree->lineNum);
 			}
 		}
 		
-		//vector<string> as string
-		string stringVector(vector<string> v) {
+		//list as string
+		string stringVector(const ListView &v) {
 			string str;
-			for(int i=0; i<v.size(); i++) {
+			ScopedCharge charge(ctx.memory, A_String);
+			char digits[24];
+			for(size_t i=0; i<v.size(); i++) {
+				if(str.size() + sizeof(digits) > str.capacity()) {
+					size_t capacity = max((size_t)64, 2 * str.capacity());
+					charge.grow(capacity);
+					str.reserve(capacity);
+				}
 				if(i != 0)
 					str += ", ";
-				str += v[i];
+				char* end = to_chars(digits, digits + sizeof(digits), v[i]).ptr;
+				str.append(digits, end - digits);
 			}
 			return str;
 		}
@@ -0,0 +1,102 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+enum KeywordKind {
+	K_NONE, //not a keyword, i.e. an identifier
+	K_IF, K_ELSE, K_DEF, K_WHILE, K_FOR, K_IN, K_RETURN, K_PRINT, K_LEN
+};
+
+struct Keyword {
+	const char* text;
+	size_t len;
+	KeywordKind kind;
+	bool opensBlock; //starts an indented block (the lexer tracks its position)
+};
+
+//the keyword set; add new keywords here, the hash below is regenerated at compile time
+constexpr Keyword keywordList[] = {
+	{"if", 2, K_IF, true},
+	{"else", 4, K_ELSE, true},
+	{"def", 3, K_DEF, true},
+	{"while", 5, K_WHILE, true},
+	{"for", 3, K_FOR, true},
+	{"in", 2, K_IN, false},
+	{"return", 6, K_RETURN, false},
+	{"print", 5, K_PRINT, false},
+	{"len", 3, K_LEN, false}
+};
+constexpr size_t KEYWORD_COUNT = sizeof(keywordList) / sizeof(keywordList[0]);
+
+/*====perfect hash====*/
+//multiplicative hash of (first char, last char, length); a seed that gives every
+//keyword its own slot is searched for by the compiler
+constexpr unsigned KEYWORD_HASH_BITS = 5;
+constexpr unsigned KEYWORD_TABLE_SIZE = 1u << KEYWORD_HASH_BITS;
+
+constexpr unsigned keywordHash(const char* s, size_t len, uint32_t seed) {
+	uint32_t key = ((uint32_t)(unsigned char)s[0] << 16) | ((uint32_t)(unsigned char)s[len-1] << 8) | (uint32_t)len;
+	return (uint32_t)(key * seed) >> (32 - KEYWORD_HASH_BITS);
+}
+
+constexpr bool seedIsPerfect(uint32_t seed) {
+	bool used[KEYWORD_TABLE_SIZE] = {};
+	for(size_t i=0; i<KEYWORD_COUNT; i++) {
+		unsigned h = keywordHash(keywordList[i].text, keywordList[i].len, seed);
+		if(used[h])
+			return false;
+		used[h] = true;
+	}
+	return true;
+}
+
+constexpr uint32_t findKeywordSeed() {
+	for(uint32_t seed=0x9e3779b1u; seed<0x9e3779b1u + 100000; seed+=2) {
+		if(seedIsPerfect(seed))
+			return seed;
+	}
+	return 0;
+}
+
+constexpr uint32_t KEYWORD_SEED = findKeywordSeed();
+static_assert(KEYWORD_SEED != 0, "no perfect hash seed for the keyword set, raise KEYWORD_HASH_BITS");
+
+struct KeywordSlots {
+	signed char index[KEYWORD_TABLE_SIZE]; //into keywordList, -1 if empty
+};
+
+constexpr KeywordSlots makeKeywordSlots() {
+	KeywordSlots slots = {};
+	for(unsigned i=0; i<KEYWORD_TABLE_SIZE; i++)
+		slots.index[i] = -1;
+	for(size_t i=0; i<KEYWORD_COUNT; i++)
+		slots.index[keywordHash(keywordList[i].text, keywordList[i].len, KEYWORD_SEED)] = i;
+	return slots;
+}
+
+constexpr KeywordSlots keywordSlots = makeKeywordSlots();
+
+constexpr size_t longestKeyword() {
+	size_t longest = 0;
+	for(size_t i=0; i<KEYWORD_COUNT; i++)
+		longest = (keywordList[i].len > longest) ? keywordList[i].len : longest;
+	return longest;
+}
+/*==end perfect hash==*/
+
+//the keyword s[0..len) spells, or nullptr for an identifier; one hash and one compare
+inline const Keyword* lookupKeyword(const char* s, size_t len) {
+	if(len == 0 || len > longestKeyword())
+		return nullptr;
+	int i = keywordSlots.index[keywordHash(s, len, KEYWORD_SEED)];
+	if(i < 0 || keywordList[i].len != len || memcmp(keywordList[i].text, s, len) != 0)
+		return nullptr;
+	return &keywordList[i];
+}
+
+#endif
\ No newline at end of file
@@ -6,10 +6,64 @@
 #include <vector>
 #include <stack>
 #include "tokens.h"
+#include "scan.h"
+#include "keywords.h"
 #include "error.h"
 
 using namespace std;
 
+//character classes for the lexer's dispatch table
+enum CharClass {
+	C_INVALID, C_END, C_BLANK, C_DIGIT, C_ALPHA,
+	C_OPERATOR, C_SEPARATOR, C_QUOTE, C_COMMENT
+};
+
+struct CharTable {
+	CharClass charClass[256];
+	TokenType tokenType[256]; //for single character operators and separators
+};
+
+constexpr CharTable makeCharTable() {
+	CharTable table = {};
+	for(int c=0; c<256; c++) {
+		table.charClass[c] = C_INVALID;
+		table.tokenType[c] = T_NONE;
+	}
+	for(int c='0'; c<='9'; c++)
+		table.charClass[c] = C_DIGIT;
+	for(int c='a'; c<='z'; c++)
+		table.charClass[c] = C_ALPHA;
+	for(int c='A'; c<='Z'; c++)
+		table.charClass[c] = C_ALPHA;
+	
+	table.charClass[(unsigned char)'\0'] = C_END;
+	table.charClass[(unsigned char)' '] = C_BLANK;
+	table.charClass[(unsigned char)'\t'] = C_BLANK;
+	table.charClass[(unsigned char)'\"'] = C_QUOTE;
+	table.charClass[(unsigned char)'#'] = C_COMMENT;
+	
+	const char operators[] = "+-*/=><!";
+	const TokenType operatorTypes[] = {T_Plus, T_Minus, T_Mult, T_Div, T_EQ, T_Greater, T_Less, T_Not};
+	for(int i=0; i<8; i++) {
+		table.charClass[(unsigned char)operators[i]] = C_OPERATOR;
+		table.tokenType[(unsigned char)operators[i]] = operatorTypes[i];
+	}
+	
+	const char separators[] = "()[],:.";
+	const TokenType separatorTypes[] = {T_OpenParen, T_CloseParen, T_OpenBracket, T_CloseBracket, T_Comma, T_Colon, T_Dot};
+	for(int i=0; i<7; i++) {
+		table.charClass[(unsigned char)separators[i]] = C_SEPARATOR;
+		table.tokenType[(unsigned char)separators[i]] = separatorTypes[i];
+	}
+	return table;
+}
+
+constexpr CharTable charTable = makeCharTable();
+
+inline CharClass classOf(char c) {
+	return charTable.charClass[(unsigned char)c];
+}
+
 class LexicalAnalyzer {
 	private:
 		string line;
@@ -19,11 +73,24 @@ class LexicalAnalyzer {
 		vector<Token> tokens;
 		stack<int> keywordPositions;
 		
-		void incrementChar() {
-			currPos += 1;
+		//moves to position pos of the line
+		void jumpTo(size_t pos) {
+			currPos = pos;
 			currChar = (currPos < line.size()) ? line[currPos] : '\0';
 		}
 		
+		void incrementChar() {
+			jumpTo(currPos + 1);
+		}
+		
+		//end of the run of characters of class a or b starting at pos
+		size_t spanEnd(size_t pos, CharClass a, CharClass b) {
+			size_t len = line.size();
+			while(pos < len && (classOf(line[pos]) == a || classOf(line[pos]) == b))
+				pos++;
+			return pos;
+		}
+		
 	public:
 		void initialize(string currLine, int currLineNum) {
 			line = currLine;
@@ -38,149 +105,121 @@ class LexicalAnalyzer {
 			return tokens;
 		}
 		
+		//each character is dispatched on its class from charTable; blanks and
+		//string bodies are skipped with vector scans (see scan.h)
 		void tokenize() {
-			while(currChar != '\0') {
-				//comments
-				if(currChar == '#') {
-					addEndStmntTokenIfNecessary();
-					while(currChar != '\0')
+			while(true) {
+				switch(classOf(currChar)) {
+					//a '\0' ends the line, as the end of the string does
+					case C_END: {
+						//marks the end of the line
+						tokens.push_back(Token(T_EndLine, "", lineNumber, -1));
+						return;
+					}
+					//comments run to the end of the line
+					case C_COMMENT: {
+						addEndStmntTokenIfNecessary();
+						jumpTo(line.size());
+						break;
+					}
+					//empty space
+					case C_BLANK: {
+						goToNotEmpty();
+						addEndStmntTokenIfNecessary();
+						break;
+					}
+					//operator
+					case C_OPERATOR: {
+						addEndStmntTokenIfNecessary();
+						tokens.push_back(getOperatorToken(currChar));
 						incrementChar();
-					continue;
-				}
-				//empty space
-				else if(isblank(currChar)) {
-					goToNotEmpty();
-					addEndStmntTokenIfNecessary();
-					continue;
-				}
-				//operator
-				else if(currChar == '+' || currChar == '-' || currChar == '*' || currChar == '/' || 
-						currChar == '=' || currChar == '>' || currChar == '<') {
-					addEndStmntTokenIfNecessary();
-					tokens.push_back(getOperatorToken(currChar));
-					incrementChar();
-					continue;
-				}
-				//separator
-				else if(currChar == '(' || currChar == ')' || currChar == '[' || currChar == ']' ||
-						currChar == ',' || currChar == ':') {
-					addEndStmntTokenIfNecessary();
-					tokens.push_back(getSeparatorToken(currChar));
-					incrementChar();
-					continue;
-				}
-				//integer
-				else if(isdigit(currChar)) {
-					addEndStmntTokenIfNecessary();
-					tokens.push_back(Token(T_INT, makeInteger(), lineNumber, currPos));
-					continue;
-				}
-				//string literal
-				else if(currChar == '\"') {
-					addEndStmntTokenIfNecessary();
-					incrementChar();
-					string tk = makeStringLiteral();
-					tokens.push_back(Token(T_String_Literal, tk, lineNumber, currPos));
-					incrementChar();
-					continue;
-				}
-				//identifiers and keywords
-				else if(isalpha(currChar)) {
-					addEndStmntTokenIfNecessary();
-					int firstPos = currPos;
-					string tk = makeLiteral();
-					if(isKeyword(tk)) {
-						tokens.push_back(Token(T_Keyword, tk, lineNumber, currPos));
-						if(tk == "if" || tk == "else" || tk == "def" || tk == "while") {
-							keywordPositions.push(firstPos);
+						break;
+					}
+					//separator
+					case C_SEPARATOR: {
+						addEndStmntTokenIfNecessary();
+						tokens.push_back(getSeparatorToken(currChar));
+						incrementChar();
+						break;
+					}
+					//integer
+					case C_DIGIT: {
+						addEndStmntTokenIfNecessary();
+						string tk = makeInteger();
+						tokens.push_back(Token(T_INT, tk, lineNumber, currPos));
+						break;
+					}
+					//string literal
+					case C_QUOTE: {
+						addEndStmntTokenIfNecessary();
+						incrementChar();
+						string tk = makeStringLiteral();
+						tokens.push_back(Token(T_String_Literal, tk, lineNumber, currPos));
+						incrementChar();
+						break;
+					}
+					//identifiers and keywords
+					case C_ALPHA: {
+						addEndStmntTokenIfNecessary();
+						int firstPos = currPos;
+						jumpTo(spanEnd(firstPos, C_ALPHA, C_DIGIT));
+						//one perfect hash lookup on the span, before any string is built
+						const Keyword* kw = lookupKeyword(line.data() + firstPos, currPos - firstPos);
+						string tk = line.substr(firstPos, currPos - firstPos);
+						if(kw != nullptr) {
+							tokens.push_back(Token(T_Keyword, tk, lineNumber, currPos));
+							if(kw->opensBlock) {
+								keywordPositions.push(firstPos);
+							}
+						} else {
+							tokens.push_back(Token(T_Identifier, tk, lineNumber, currPos));
 						}
-					} else {
-						tokens.push_back(Token(T_Identifier, tk, lineNumber, currPos));
+						break;
+					}
+					//error
+					default: {
+						RaiseError(InvalidCharacterError, string(1,currChar), lineNumber);
 					}
-					continue;
-				}
-				//error
-				else {
-					RaiseError(InvalidCharacterError, string(1,currChar), lineNumber);
 				}
 			}
-			//marks the end of the line
-			tokens.push_back(Token(T_EndLine, "", lineNumber, -1));
 		}
 		
 		//goes to the next non-empty char
 		void goToNotEmpty() {
-			while(currChar != '\0' && isblank(currChar)) {
-				incrementChar();
-			}
+			jumpTo(skipBlanks(line.data(), currPos, line.size()));
 		}
 		//returns operator token
 		Token getOperatorToken(char c) {
-			switch(c) {
-				case '+': return Token(T_Plus, string(1,c), lineNumber, currPos);
-				case '-': return Token(T_Minus, string(1,c), lineNumber, currPos);
-				case '*': return Token(T_Mult, string(1,c), lineNumber, currPos);
-				case '/': return Token(T_Div, string(1,c), lineNumber, currPos);
-				case '=': return Token(T_EQ, string(1,c), lineNumber, currPos);
-				case '>': return Token(T_Greater, string(1,c), lineNumber, currPos);
-				case '<': return Token(T_Less, string(1,c), lineNumber, currPos);
-				default: return Token(T_OPERATOR, string(1,c), lineNumber, currPos);
-			}
+			TokenType type = charTable.tokenType[(unsigned char)c];
+			return Token((type != T_NONE) ? type : T_OPERATOR, string(1,c), lineNumber, currPos);
 		}
 		//returns separator token
 		Token getSeparatorToken(char c) {
-			switch(c) {
-				case '(': return Token(T_OpenParen, string(1,c), lineNumber, currPos);
-				case ')': return Token(T_CloseParen, string(1,c), lineNumber, currPos);
-				case '[': return Token(T_OpenBracket, string(1,c), lineNumber, currPos);
-				case ']': return Token(T_CloseBracket, string(1,c), lineNumber, currPos);
-				case ',': return Token(T_Comma, string(1,c), lineNumber, currPos);
-				case ':': return Token(T_Colon, string(1,c), lineNumber, currPos);
-				default: return Token(T_SEPARATOR, string(1,c), lineNumber, currPos);
-			}
+			TokenType type = charTable.tokenType[(unsigned char)c];
+			return Token((type != T_NONE) ? type : T_SEPARATOR, string(1,c), lineNumber, currPos);
 		}
 		//returns the integer as a string
 		string makeInteger() {
-			string int_str = "";
-			while(currChar != '\0' && isdigit(currChar)) {
-				int_str += currChar;
-				incrementChar();
-			}
-			return int_str;
+			size_t start = currPos;
+			jumpTo(spanEnd(start, C_DIGIT, C_DIGIT));
+			return line.substr(start, currPos - start);
 		}
 		//returns the string literal as a string
 		string makeStringLiteral() {
-			string lit = "";
-			while(currChar != '\0' && currChar != '\"') {
-				lit += currChar;
-				incrementChar();
-			}
+			size_t start = currPos;
+			jumpTo(findQuote(line.data(), start, line.size()));
 			//if no end quote found
 			if(currChar != '\"'){
-				//TODO: make error class and invoke here
-				// cout << "Error: Expected \" at line " << lineNumber << endl;
-				// exit(0);
 				RaiseError(DefaultError, string(1,currChar), lineNumber);
 			}
-			return lit;
-		}
-		//returns identifier or keyword as a string
-		string makeLiteral() {
-			string lit = "";
-			while(currChar != '\0' && isalnum(currChar)) {
-				lit += currChar;
-				incrementChar();
-			}
-			return lit;
+			return line.substr(start, currPos - start);
 		}
 		//returns true if given string is a keyword
-		bool isKeyword(string str) {
-			if(str == "if" || str == "else" || str == "def" || str == "while" || str == "return" || str == "print" || str == "len") {
-				return true;
-			}
-			return false;
+		bool isKeyword(const string &str) {
+			return lookupKeyword(str.data(), str.size()) != nullptr;
 		}
-		//adds a end statement token if the if/else/while/def block has ended
+		//adds a end statement token if the if/else/while/for/def block has ended,
+		//and at the end of the file ends every block and adds an EOF token
 		void addEndStmntTokenIfNecessary(bool eofFlag=false) {
 			if(eofFlag) {
 				while(!keywordPositions.empty()) {
@@ -188,6 +227,12 @@ class LexicalAnalyzer {
 					tokens.push_back(Token(T_EndLine, "", lineNumber, currPos));
 					keywordPositions.pop();
 				}
+				tokens.push_back(Token(T_EOF, "", lineNumber, currPos));
+				return;
+			}
+			
+			//blank and comment only lines don't end blocks
+			if(classOf(currChar) == C_END || classOf(currChar) == C_COMMENT) {
 				return;
 			}
 			
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "libminipython.h"
+#include "tokens.h"
+#include "lexer.h"
+#include "parser.h"
+#include "ast.h"
+#include "global_scope.h"
+#include "interpreter.h"
+#include "pipeline.h"
+#include "runner.h"
+#include "server.h"
+#include "snapshot.h"
+#include "error.h"
+
+using namespace std;
+
+//streambuf that hands every complete line to a callback
+class CallbackStreamBuf : public streambuf {
+	private:
+		function<void(const string&)> callback;
+		string line;
+		
+	protected:
+		int overflow(int c) {
+			if(c == EOF)
+				return 0;
+			line += (char)c;
+			if(c == '\n') {
+				callback(line);
+				line.clear();
+			}
+			return c;
+		}
+		
+		streamsize xsputn(const char* s, streamsize n) {
+			for(streamsize i=0; i<n; i++)
+				overflow(s[i]);
+			return n;
+		}
+		
+		int sync() {
+			if(!line.empty()) {
+				callback(line);
+				line.clear();
+			}
+			return 0;
+		}
+		
+	public:
+		CallbackStreamBuf(function<void(const string&)> inCallback) {
+			callback = inCallback;
+		}
+};
+
+//streambuf that appends to a caller owned string
+class StringStreamBuf : public streambuf {
+	private:
+		string* buffer;
+		
+	protected:
+		int overflow(int c) {
+			if(c != EOF)
+				buffer->push_back((char)c);
+			return c;
+		}
+		
+		streamsize xsputn(const char* s, streamsize n) {
+			buffer->append(s, n);
+			return n;
+		}
+		
+	public:
+		StringStreamBuf(string* inBuffer) {
+			buffer = inBuffer;
+		}
+};
+
+MiniPython::MiniPython() {
+	ctx = new InterpreterContext();
+	outStream = &cout;
+	outBuf = nullptr;
+	ctx->out = outStream;
+	optimize = false;
+	keepGlobals = true;
+	statsStream = nullptr;
+}
+
+MiniPython::~MiniPython() {
+	setOutputStream(cout);
+	delete ctx;
+}
+
+void MiniPython::setOutput(streambuf* buf) {
+	if(outBuf != nullptr) {
+		outStream->flush();
+		delete outStream;
+		delete outBuf;
+	}
+	outBuf = buf;
+	if(buf != nullptr)
+		outStream = new ostream(buf);
+	ctx->out = outStream;
+}
+
+void MiniPython::setOutputStream(ostream &os) {
+	setOutput(nullptr);
+	outStream = &os;
+	ctx->out = outStream;
+}
+
+void MiniPython::setOutputCallback(function<void(const string&)> callback) {
+	setOutput(new CallbackStreamBuf(callback));
+}
+
+void MiniPython::setOutputBuffer(string* buffer) {
+	setOutput(new StringStreamBuf(buffer));
+}
+
+void MiniPython::setOptimize(bool on, bool inKeepGlobals) {
+	optimize = on;
+	keepGlobals = inKeepGlobals;
+}
+
+void MiniPython::setStatsStream(ostream* os) {
+	statsStream = os;
+}
+
+void MiniPython::setMemoCapacity(size_t capacity) {
+	ctx->memoCapacity = capacity;
+	ctx->memo.clear();
+	ctx->memoNodes.clear();
+}
+
+//the limits an InterpreterContext takes
+static ScriptLimits scriptLimits(const MiniPythonLimits &limits) {
+	ScriptLimits converted;
+	converted.maxMemory = limits.maxMemory;
+	converted.maxSteps = limits.maxSteps;
+	converted.timeoutMs = limits.timeoutMs;
+	return converted;
+}
+
+void MiniPython::setMaxMemory(size_t bytes) {
+	ScriptLimits limits = ctx->limits;
+	limits.maxMemory = bytes;
+	ctx->setLimits(limits);
+}
+
+void MiniPython::setMaxSteps(unsigned long long steps) {
+	ctx->limits.maxSteps = steps;
+}
+
+void MiniPython::setTimeout(unsigned long ms) {
+	ctx->limits.timeoutMs = ms;
+}
+
+void MiniPython::setLimits(const MiniPythonLimits &limits) {
+	ctx->setLimits(scriptLimits(limits));
+}
+
+bool MiniPython::writeOpcodeStats(ostream &os, bool json) {
+#ifdef OPCODE_STATS
+	if(json) {
+		ctx->opcodeStats.writeJson(os);
+	} else {
+		ctx->opcodeStats.writeTable(os);
+	}
+	return true;
+#else
+	(void)os; //nothing was counted
+	(void)json;
+	return false;
+#endif
+}
+
+int MiniPython::run(istream &source, bool pipelined) {
+	int exitCode;
+	if(optimize && !pipelined) {
+		exitCode = runOptimizedScript(source, *ctx, keepGlobals, statsStream, &errMsg);
+	} else {
+		exitCode = runScript(source, *ctx, pipelined, &errMsg);
+	}
+	outStream->flush();
+	return exitCode;
+}
+
+int MiniPython::runSource(const string &source, bool pipelined) {
+	istringstream sourceStream(source);
+	return run(sourceStream, pipelined);
+}
+
+int MiniPython::runFile(const string &path, bool pipelined) {
+	ifstream inputProgram(path);
+	if(!inputProgram.is_open()) {
+		errMsg = "minipython: can't open file \'" + path + "\', no such file in directory";
+		return -1;
+	}
+	return run(inputProgram, pipelined);
+}
+
+string MiniPython::lastError() {
+	return errMsg;
+}
+
+bool MiniPython::getVariable(const string &name, MiniPythonValue &val) {
+	SymbolEntry* var = ctx->findSymbol(name);
+	if(var == nullptr)
+		return false;
+	
+	val.listVal.clear();
+	if(var->type == INT) {
+		val.type = MP_INT;
+		val.intVal = var->num;
+		return true;
+	}
+	if(var->type == LIST) {
+		val.type = MP_LIST;
+		val.intVal = 0;
+		val.listVal.assign(var->list.begin(), var->list.end());
+		return true;
+	}
+	
+	val.type = MP_NONE;
+	return true;
+}
+
+int MiniPython::saveSnapshot(const string &path) {
+	string err = writeSnapshot(*ctx, path);
+	errMsg = (err == "") ? "" : "minipython: " + err;
+	return (err == "") ? 0 : -1;
+}
+
+int MiniPython::loadSnapshot(const string &path) {
+	string err = readSnapshot(*ctx, path);
+	errMsg = (err == "") ? "" : "minipython: " + err;
+	return (err == "") ? 0 : -1;
+}
+
+void MiniPython::reset() {
+	ctx->reset();
+	errMsg = "";
+}
+
+int miniPythonRunBatch(const vector<string> &scripts, int numThreads, ostream &out, const MiniPythonLimits &limits) {
+	BatchRunner runner;
+	return runner.run(scripts, numThreads, out, scriptLimits(limits));
+}
+
+int miniPythonServe(const string &socketPath, int numThreads, const MiniPythonLimits &limits) {
+	ScriptServer server;
+	return server.serve(socketPath, numThreads, scriptLimits(limits));
+}
+
+int miniPythonClient(const string &socketPath, const string &script, ostream &out) {
+	return runClient(socketPath, script, out);
+}
\ No newline at end of file
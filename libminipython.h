@@ -0,0 +1,124 @@
+#ifndef LIBMINIPYTHON_H
+#define LIBMINIPYTHON_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+
+//embedding API for minipython; the interpreter headers are only included by
+//libminipython.cpp, so this is all a client has to see
+
+struct InterpreterContext;
+
+enum MiniPythonType {MP_NONE, MP_INT, MP_LIST};
+
+//limits of a run, 0 for none; a run going over one stops with an error
+struct MiniPythonLimits {
+	size_t maxMemory = 0; //bytes allocated for lists, strings and the stack
+	unsigned long long maxSteps = 0; //loop iterations
+	unsigned long timeoutMs = 0; //wall clock
+};
+
+//value of a script variable
+struct MiniPythonValue {
+	MiniPythonType type = MP_NONE;
+	long long intVal = 0;
+	std::vector<long long> listVal;
+};
+
+class MiniPython {
+	private:
+		InterpreterContext* ctx;
+		std::ostream* outStream; //stream the script's output goes to
+		std::streambuf* outBuf; //owned buffer behind outStream, when redirected
+		std::string errMsg;
+		bool optimize; //compile the whole script and optimize it before running
+		bool keepGlobals; //the optimizer keeps the final value of every variable
+		std::ostream* statsStream; //where run statistics go, nullptr for none
+		
+		void setOutput(std::streambuf* buf);
+		int run(std::istream &source, bool pipelined);
+		
+	public:
+		MiniPython();
+		~MiniPython();
+		MiniPython(const MiniPython&) = delete;
+		MiniPython& operator=(const MiniPython&) = delete;
+		
+		/*====output====*/
+		//print() output (and error messages, as the CLI prints them) go to stdout by default
+		void setOutputStream(std::ostream &os);
+		//called once per printed line, with the trailing newline
+		void setOutputCallback(std::function<void(const std::string&)> callback);
+		//appends everything printed to *buffer
+		void setOutputBuffer(std::string* buffer);
+		/*==end output==*/
+		
+		/*====running====*/
+		//compiles each (not pipelined) script whole and removes stores nobody
+		//reads before running it; off by default. With keepGlobals off, variables
+		//the script never reads may be missing from getVariable() afterwards
+		void setOptimize(bool on, bool keepGlobals=true);
+		//prints statistics of every optimized run to *os, nullptr turns it off
+		void setStatsStream(std::ostream* os);
+		//caches the results of up to capacity expressions of optimized runs and
+		//reuses them until a variable they read is written; 0 (the default) is off
+		void setMemoCapacity(size_t capacity);
+		//limits what a run may allocate for lists, strings and its stack to
+		//bytes; a run going over it stops with a MemoryError. 0 (the default) is no limit
+		void setMaxMemory(size_t bytes);
+		//stops a run once its loops have gone around steps times, counting every
+		//iteration of every loop; 0 (the default) is no limit
+		void setMaxSteps(unsigned long long steps);
+		//stops a run that takes longer than ms milliseconds; a timer thread is
+		//started per run only when it is set. 0 (the default) is no limit
+		void setTimeout(unsigned long ms);
+		//all of the above at once
+		void setLimits(const MiniPythonLimits &limits);
+		//writes how often each node kind, and each pair and triple of node kinds
+		//in a row, ran in every run so far, and the operand types each + and []
+		//saw, as sorted tables or as JSON. Only builds compiled with -DOPCODE_STATS
+		//count; returns false (writing nothing) in others
+		bool writeOpcodeStats(std::ostream &os, bool json=false);
+		//runs a program held in memory; returns 0 on success, -1 on error
+		int runSource(const std::string &source, bool pipelined=false);
+		//runs a script file; returns 0 on success, -1 on error
+		int runFile(const std::string &path, bool pipelined=false);
+		//message of the error that stopped the last run, "" if it succeeded
+		std::string lastError();
+		/*==end running==*/
+		
+		//fetches a global variable; returns false if it is not defined
+		bool getVariable(const std::string &name, MiniPythonValue &val);
+		
+		/*====snapshots====*/
+		//writes every global to a binary file, list elements as raw int64
+		//arrays; returns 0 on success, -1 on error (see lastError()). Turn
+		//keepGlobals on in setOptimize() so no variable was optimized away
+		int saveSnapshot(const std::string &path);
+		//binds every global saved by saveSnapshot(), mapping the file and
+		//copying list elements straight out of it; returns 0 on success, -1 on error
+		int loadSnapshot(const std::string &path);
+		/*==end snapshots==*/
+		
+		//forgets all variables, keeping the context's storage for reuse; O(1)
+		//unless some hold lists, whose elements are freed
+		void reset();
+};
+
+//runs every script on its own context on numThreads threads, writing each
+//script's output to out in the given order; returns -1 if any script failed.
+//Each script runs with limits
+int miniPythonRunBatch(const std::vector<std::string> &scripts, int numThreads, std::ostream &out, const MiniPythonLimits &limits=MiniPythonLimits());
+
+//daemon: serves script runs on a unix domain socket with numThreads workers,
+//keeping warm contexts and compiled scripts between requests, each request
+//running with limits; does not return unless the socket can't be set up
+int miniPythonServe(const std::string &socketPath, int numThreads, const MiniPythonLimits &limits=MiniPythonLimits());
+
+//runs a script (a path, or "-" to send source from stdin) on a daemon, copying
+//its output to out; returns the same exit code as a direct run
+int miniPythonClient(const std::string &socketPath, const std::string &script, std::ostream &out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef LIST_VIEW_H
+#define LIST_VIEW_H
+
+#include <vector>
+#include <memory>
+#include "memory_budget.h"
+
+using namespace std;
+
+//elements shared by list values, charged to the budget of the script that
+//built them (if any) for as long as they are alive
+struct ListBuffer {
+	vector<long long> elems;
+	const long long* external = nullptr; //read only elements stored elsewhere (a mapped file) instead of in elems
+	shared_ptr<const void> externalOwner; //keeps them alive
+	MemoryBudget* budget = nullptr;
+	size_t charged = 0; //bytes charged to budget: elems' capacity, or the external elements
+	
+	ListBuffer(MemoryBudget* inBudget) : budget(inBudget) {}
+	ListBuffer(const ListBuffer&) = delete;
+	ListBuffer& operator=(const ListBuffer&) = delete;
+	
+	~ListBuffer() {
+		if(budget != nullptr)
+			budget->release(A_List, charged);
+	}
+	
+	//makes room for n elements, charging the budget before allocating
+	void reserve(size_t n) {
+		if(n <= elems.capacity())
+			return;
+		if(budget != nullptr) {
+			budget->charge(A_List, n * sizeof(long long) - charged);
+			charged = n * sizeof(long long);
+		}
+		elems.reserve(n);
+	}
+};
+
+//a list value (its elements are ints): the window [offset, offset+length) of a buffer that any number
+//of values share. Copying a list or slicing it is O(1); a value is copied out
+//into a buffer of its own only when it is written while the buffer is shared
+//(copy on write), so a slice keeps seeing the elements it was taken from even
+//if its parent changes afterwards
+class ListView {
+	private:
+		shared_ptr<ListBuffer> buffer; //nullptr for a list that never had elements
+		size_t offset = 0;
+		size_t length = 0;
+		
+		//gives this value a buffer holding exactly its elements that nothing
+		//else shares, with room for capacity elements; a copy is charged to the
+		//budget of the buffer it was copied from
+		void makeUnique(size_t capacity = 0) {
+			if(buffer == nullptr) {
+				buffer = make_shared<ListBuffer>(nullptr);
+			} else if(buffer.use_count() != 1 || offset != 0 || length != buffer->elems.size() || buffer->external != nullptr) {
+				shared_ptr<ListBuffer> copy = make_shared<ListBuffer>(buffer->budget);
+				copy->reserve(max(capacity, length));
+				copy->elems.assign(begin(), end());
+				buffer = copy;
+				offset = 0;
+			}
+			buffer->reserve(capacity);
+		}
+	
+	public:
+		ListView() {}
+		
+		//an empty list whose buffers are charged to budget
+		explicit ListView(MemoryBudget* budget) {
+			buffer = make_shared<ListBuffer>(budget);
+		}
+		
+		//the n elements at elems, used where they are without copying them (they
+		//are copied out the first time the list is written); owner keeps them
+		//alive for as long as a list refers to them
+		static ListView external(const long long* elems, size_t n, shared_ptr<const void> owner, MemoryBudget* budget) {
+			ListView view(budget);
+			if(budget != nullptr) {
+				budget->charge(A_List, n * sizeof(long long));
+				view.buffer->charged = n * sizeof(long long);
+			}
+			view.buffer->external = elems;
+			view.buffer->externalOwner = owner;
+			view.length = n;
+			return view;
+		}
+		
+		size_t size() const {
+			return length;
+		}
+		
+		long long operator[](size_t i) const {
+			return begin()[i];
+		}
+		
+		const long long* begin() const {
+			if(buffer == nullptr)
+				return nullptr;
+			return ((buffer->external != nullptr) ? buffer->external : buffer->elems.data()) + offset;
+		}
+		
+		const long long* end() const {
+			return begin() + length;
+		}
+		
+		//elements [from, size()), sharing this value's buffer
+		ListView slice(size_t from) const {
+			ListView view = *this;
+			view.offset += from;
+			view.length -= from;
+			return view;
+		}
+		
+		//makes room for n elements, so appending up to n doesn't reallocate
+		void reserve(size_t n) {
+			makeUnique(n);
+		}
+		
+		//replaces the elements with a copy of elems[0, n), copied in one pass
+		void assign(const long long* elems, size_t n) {
+			length = 0;
+			makeUnique(n);
+			buffer->elems.assign(elems, elems + n);
+			length = n;
+		}
+		
+		//element i, for writing
+		long long& mutableAt(size_t i) {
+			makeUnique();
+			return buffer->elems[i];
+		}
+		
+		void push_back(long long elem) {
+			makeUnique();
+			vector<long long> &elems = buffer->elems;
+			if(elems.size() == elems.capacity())
+				buffer->reserve(max((size_t)4, 2 * elems.capacity()));
+			elems.push_back(elem);
+			length++;
+		}
+		
+		//keeps the first keep (<= size()) elements and appends tail's elements after them
+		void replaceTail(size_t keep, const ListView &tail) {
+			ListView src = tail; //holds tail's buffer, in case it is this one
+			if(buffer != nullptr && buffer.use_count() == 1 && offset == 0 && buffer->external == nullptr) {
+				buffer->elems.resize(keep);
+			}
+			length = keep;
+			makeUnique(keep + src.size()); //copies only the kept elements
+			buffer->elems.insert(buffer->elems.end(), src.begin(), src.end());
+			length = buffer->elems.size();
+		}
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+//what the interpreter allocates on a script's behalf, counted separately
+enum AllocClass {
+	A_List, //list element buffers
+	A_String, //strings built at run time (printing a list)
+	A_Frame, //the value stack
+	NUM_ALLOC_CLASSES
+};
+
+string allocClassName(AllocClass allocClass) {
+	switch(allocClass) {
+		case A_List: return "list";
+		case A_String: return "string";
+		default: return "frame";
+	}
+}
+
+//thrown by MemoryBudget::charge(); the interpreter turns it into a MemoryError
+//at the line it was running
+struct MemoryLimitExceeded {
+	AllocClass allocClass;
+	size_t bytes; //size of the allocation that was refused
+	size_t used[NUM_ALLOC_CLASSES]; //bytes held per class when it was refused
+};
+
+//bytes a script holds, per allocation class, against an optional ceiling.
+//Buffers are charged when their capacity changes, before they allocate, not
+//per byte written, so counting is an add and a compare per allocation and is
+//always on
+struct MemoryBudget {
+	size_t limit = 0; //0 for no ceiling
+	size_t used[NUM_ALLOC_CLASSES] = {};
+	size_t peak[NUM_ALLOC_CLASSES] = {};
+	size_t total = 0;
+	size_t totalPeak = 0;
+	
+	//counts bytes about to be allocated, throws MemoryLimitExceeded (counting
+	//nothing) if they would take the total over the limit
+	void charge(AllocClass allocClass, size_t bytes) {
+		if(limit != 0 && (bytes > limit || total > limit - bytes)) {
+			MemoryLimitExceeded e = {allocClass, bytes, {}};
+			copy(used, used + NUM_ALLOC_CLASSES, e.used);
+			throw e;
+		}
+		used[allocClass] += bytes;
+		total += bytes;
+		peak[allocClass] = max(peak[allocClass], used[allocClass]);
+		totalPeak = max(totalPeak, total);
+	}
+	
+	void release(AllocClass allocClass, size_t bytes) {
+		used[allocClass] -= bytes;
+		total -= bytes;
+	}
+};
+
+//a buffer that lives for one scope: its charge grows with it and is released
+//when the scope ends, error or not
+class ScopedCharge {
+	private:
+		MemoryBudget &budget;
+		AllocClass allocClass;
+		size_t bytes = 0;
+	
+	public:
+		ScopedCharge(MemoryBudget &inBudget, AllocClass inClass) : budget(inBudget), allocClass(inClass) {}
+		ScopedCharge(const ScopedCharge&) = delete;
+		ScopedCharge& operator=(const ScopedCharge&) = delete;
+		
+		~ScopedCharge() {
+			budget.release(allocClass, bytes);
+		}
+		
+		//raises the charge to newBytes, call before growing the buffer to that size
+		void grow(size_t newBytes) {
+			if(newBytes > bytes) {
+				budget.charge(allocClass, newBytes - bytes);
+				bytes = newBytes;
+			}
+		}
+};
+
+#endif
@@ -1,82 +1,175 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <stack>
+#include <thread>
+#include <cctype>
 
-#include "tokens.h"
-#include "lexer.h"
-#include "parser.h"
-#include "ast.h"
-#include "global_scope.h"
-#include "interpreter.h"
-#include "error.h"
-#include "DebugFuncs.h"
+#include "libminipython.h"
 
 using namespace std;
 
-bool inBlock = false;
+//parses a byte count with an optional K, M or G suffix (powers of 1024), e.g.
+//512M; returns false if text isn't one
+bool parseMemorySize(const string &text, size_t &bytes) {
+	size_t digits = 0;
+	while(digits < text.size() && isdigit((unsigned char)text[digits]))
+		digits++;
+	if(digits == 0 || digits > 15 || text.size() - digits > 1)
+		return false;
+	
+	bytes = stoull(text.substr(0, digits));
+	if(digits < text.size()) {
+		switch(toupper((unsigned char)text[digits])) {
+			case 'K': bytes <<= 10; break;
+			case 'M': bytes <<= 20; break;
+			case 'G': bytes <<= 30; break;
+			default: return false;
+		}
+	}
+	return true;
+}
+
+//parses a plain decimal count, e.g. 5000; returns false if text isn't one or
+//doesn't fit count
+bool parseCount(const string &text, unsigned long long &count) {
+	if(text.empty() || text.size() > 19)
+		return false;
+	for(char c: text) {
+		if(!isdigit((unsigned char)c))
+			return false;
+	}
+	count = stoull(text);
+	return true;
+}
 
 int main(int argc, char *argv[]) {
-	/*====file input====*/
+	/*====options====*/
+	bool pipelined = false;
+	bool batch = false;
+	bool optimize = true;
+	bool stats = false;
+	size_t memoCapacity = 0;
+	MiniPythonLimits limits;
+	string serveSocket = "";
+	string clientSocket = "";
+	string snapshotIn = "";
+	string snapshotOut = "";
+	bool opcodeStats = false;
+	string opcodeStatsJson = ""; //file the JSON goes to, if any
+	int numThreads = thread::hardware_concurrency();
+	vector<string> inFiles;
+	for(int i=1; i<argc; i++) {
+		string arg = argv[i];
+		if(arg == "--pipeline") {
+			pipelined = true;
+		} else if(arg == "--no-optimize") {
+			optimize = false;
+		} else if(arg == "--stats") {
+			stats = true;
+		} else if(arg == "--memo") {
+			memoCapacity = 1024;
+		} else if(arg.rfind("--memo=", 0) == 0) {
+			memoCapacity = atoi(arg.substr(7).c_str());
+		} else if(arg.rfind("--max-memory=", 0) == 0) {
+			if(!parseMemorySize(arg.substr(13), limits.maxMemory)) {
+				cout << "minipython: invalid memory size '" << arg.substr(13) << "', expected e.g. 512M" << endl;
+				return 0;
+			}
+		} else if(arg.rfind("--max-steps=", 0) == 0) {
+			if(!parseCount(arg.substr(12), limits.maxSteps)) {
+				cout << "minipython: invalid step count '" << arg.substr(12) << "', expected e.g. 1000000" << endl;
+				return 0;
+			}
+		} else if(arg.rfind("--timeout=", 0) == 0) {
+			unsigned long long ms = 0;
+			if(!parseCount(arg.substr(10), ms)) {
+				cout << "minipython: invalid timeout '" << arg.substr(10) << "', expected milliseconds e.g. 5000" << endl;
+				return 0;
+			}
+			limits.timeoutMs = ms;
+		} else if(arg.rfind("--snapshot-in=", 0) == 0) {
+			snapshotIn = arg.substr(14);
+		} else if(arg.rfind("--snapshot-out=", 0) == 0) {
+			snapshotOut = arg.substr(15);
+		} else if(arg == "--opcode-stats") {
+			opcodeStats = true;
+		} else if(arg.rfind("--opcode-stats=", 0) == 0) {
+			opcodeStats = true;
+			opcodeStatsJson = arg.substr(15);
+		} else if(arg == "--batch") {
+			batch = true;
+		} else if(arg == "--serve" && i+1 < argc) {
+			serveSocket = argv[++i];
+		} else if(arg == "--client" && i+1 < argc) {
+			clientSocket = argv[++i];
+		} else if(arg.rfind("--jobs=", 0) == 0) {
+			numThreads = atoi(arg.substr(7).c_str());
+		} else {
+			inFiles.push_back(arg);
+		}
+	}
+	/*==end options==*/
+	
+	//daemon, runs until killed
+	if(serveSocket != "") {
+		return miniPythonServe(serveSocket, numThreads, limits);
+	}
+	
 	//check if input file is provided
-	if(argc < 2) {
+	if(inFiles.empty()) {
 		cout << "minipython: no input file provided" << endl;
 		return 0;
 	}
 	
-	string inFile = argv[1];
-	ifstream inputProgram(inFile);
+	/*====Interpreter====*/
+	//every script runs in its own context, concurrently
+	if(batch) {
+		return miniPythonRunBatch(inFiles, numThreads, cout, limits);
+	}
+	
+	//run on a daemon started with --serve
+	if(clientSocket != "") {
+		return miniPythonClient(clientSocket, inFiles[0], cout);
+	}
 	
 	//check if file exists
+	ifstream inputProgram(inFiles[0]);
 	if(!inputProgram.is_open()) {
-		cout << "minipython: can't open file \'" << inFile << "\', no such file in directory" << endl;
-		inputProgram.close();
+		cout << "minipython: can't open file \'" << inFiles[0] << "\', no such file in directory" << endl;
 		return 0;
 	}
-	/*==end file input==*/
+	inputProgram.close();
 	
-	/*====Interpreter====*/
-	try {
-		LexicalAnalyzer lexer;
-		Parser parse;
-		Interpreter interpret;
+	//nothing reads the variables once the script is done, unless they are saved
+	MiniPython interpreter;
+	interpreter.setOptimize(optimize, snapshotOut != "");
+	interpreter.setMemoCapacity(memoCapacity);
+	interpreter.setLimits(limits);
+	if(stats)
+		interpreter.setStatsStream(&cerr);
 	
-		string line;
-		int lineCtr = 1;
-		while(getline(inputProgram, line)) {
-			/*====Lexical Analysis====*/
-			lexer.initialize(line, lineCtr);
-			lexer.tokenize();
-			if(inputProgram.peek() == EOF) {
-				lexer.addEndStmntTokenIfNecessary(true);
+	//resume from the globals a setup script left
+	if(snapshotIn != "" && interpreter.loadSnapshot(snapshotIn) != 0) {
+		cout << interpreter.lastError() << endl;
+		return -1;
+	}
+	int exitCode = interpreter.runFile(inFiles[0], pipelined);
+	
+	//what ran, also when the run failed
+	if(opcodeStats) {
+		if(!interpreter.writeOpcodeStats(cerr)) {
+			cerr << "minipython: --opcode-stats needs a build with opcode counting (make clean && make OPCODE_STATS=1)" << endl;
+		} else if(opcodeStatsJson != "") {
+			ofstream json(opcodeStatsJson);
+			if(!json.is_open() || !interpreter.writeOpcodeStats(json, true)) {
+				cerr << "minipython: can't write '" << opcodeStatsJson << "'" << endl;
 			}
-			vector<Token> tokens = lexer.getTokens();
-			//representTokenList(tokens); //debug function
-			/*==end Lexical Analysis*/
-			
-			/*====Parser====*/
-			ASTNode* tree = nullptr;
-			
-			parse.initialize(tokens);
-			parse.parseAndCreateAST();
-			tree = parse.getAST();
-			
-			//representAST(tree); cout << endl; //debug function
-			/*==end Parser==*/
-			
-			/*====Code Interpreter====*/
-			interpret.initialize(tree);
-			interpret.evaluate();
-			/*==end Code Interpreter==*/
-			
-			lineCtr++;
 		}
-		inputProgram.close();
 	}
-	
-	catch(CreateProgramError& e) {
-		cout << e.what() << endl;
+	if(exitCode == 0 && snapshotOut != "" && interpreter.saveSnapshot(snapshotOut) != 0) {
+		cout << interpreter.lastError() << endl;
 		return -1;
 	}
+	return exitCode;
 	/*==end Interpreter==*/
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#ifndef OPCODE_STATS_H
+#define OPCODE_STATS_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include "ast.h"
+
+using namespace std;
+
+//execution histogram for --opcode-stats: how often each node kind ran, each
+//pair and triple of node kinds ran one after the other (in the order the
+//interpreter visits nodes), and which operand types each + and [] saw, per
+//line. The interpreter only counts in builds with -DOPCODE_STATS (make
+//OPCODE_STATS=1); otherwise no counting code is compiled in at all
+
+const int NUM_NODE_TYPES = N_NILNode + 1;
+const int NUM_DATA_TYPES = D_NIL + 1;
+
+string nodeTypeName(int type) {
+	static const char* names[NUM_NODE_TYPES] = {
+		"N_Assign", "N_Plus",
+		"N_Var", "N_Number",
+		"N_List", "N_ListAcc", "N_List_Splice",
+		"N_Print1", "N_Print2", "N_StrLtr",
+		"N_Call",
+		"N_ifStmt", "N_BoolExpr",
+		"N_While", "N_For", "N_Block",
+		"N_NILNode"
+	};
+	return names[type];
+}
+
+string dataTypeName(int type) {
+	static const char* names[NUM_DATA_TYPES] = {"int", "list", "str", "list_acc", "none"};
+	return names[type];
+}
+
+//operand types seen at the + or [] nodes of one line
+struct OperandSite {
+	unsigned long long counts[NUM_DATA_TYPES][NUM_DATA_TYPES] = {}; //[left][right]
+	
+	//number of different type combinations seen
+	int combinations() const {
+		int n = 0;
+		for(int l=0; l<NUM_DATA_TYPES; l++) {
+			for(int r=0; r<NUM_DATA_TYPES; r++)
+				n += (counts[l][r] != 0);
+		}
+		return n;
+	}
+};
+
+class OpcodeStats {
+	private:
+		unsigned long long nodes[NUM_NODE_TYPES] = {};
+		unsigned long long pairs[NUM_NODE_TYPES][NUM_NODE_TYPES] = {};
+		unsigned long long triples[NUM_NODE_TYPES][NUM_NODE_TYPES][NUM_NODE_TYPES] = {};
+		int last[2] = {-1, -1}; //kinds of the two nodes run before, -1 for none
+		map<pair<int, int>, OperandSite> sites; //(line, node kind)
+		
+		//one row of a sorted histogram
+		struct Row {
+			string name;
+			unsigned long long count;
+		};
+		
+		static bool byCount(const Row &a, const Row &b) {
+			return (a.count != b.count) ? a.count > b.count : a.name < b.name;
+		}
+		
+		vector<Row> nodeRows() const {
+			vector<Row> rows;
+			for(int a=0; a<NUM_NODE_TYPES; a++) {
+				if(nodes[a] != 0)
+					rows.push_back({nodeTypeName(a), nodes[a]});
+			}
+			sort(rows.begin(), rows.end(), byCount);
+			return rows;
+		}
+		
+		vector<Row> pairRows() const {
+			vector<Row> rows;
+			for(int a=0; a<NUM_NODE_TYPES; a++) {
+				for(int b=0; b<NUM_NODE_TYPES; b++) {
+					if(pairs[a][b] != 0)
+						rows.push_back({nodeTypeName(a) + " " + nodeTypeName(b), pairs[a][b]});
+				}
+			}
+			sort(rows.begin(), rows.end(), byCount);
+			return rows;
+		}
+		
+		vector<Row> tripleRows() const {
+			vector<Row> rows;
+			for(int a=0; a<NUM_NODE_TYPES; a++) {
+				for(int b=0; b<NUM_NODE_TYPES; b++) {
+					for(int c=0; c<NUM_NODE_TYPES; c++) {
+						if(triples[a][b][c] != 0)
+							rows.push_back({nodeTypeName(a) + " " + nodeTypeName(b) + " " + nodeTypeName(c), triples[a][b][c]});
+					}
+				}
+			}
+			sort(rows.begin(), rows.end(), byCount);
+			return rows;
+		}
+		
+		//operand type combinations of a site, most frequent first
+		static vector<Row> operandRows(const OperandSite &site, int kind) {
+			vector<Row> rows;
+			string op = (kind == N_Plus) ? " + " : "[";
+			string close = (kind == N_Plus) ? "" : "]";
+			for(int l=0; l<NUM_DATA_TYPES; l++) {
+				for(int r=0; r<NUM_DATA_TYPES; r++) {
+					if(site.counts[l][r] != 0)
+						rows.push_back({dataTypeName(l) + op + dataTypeName(r) + close, site.counts[l][r]});
+				}
+			}
+			sort(rows.begin(), rows.end(), byCount);
+			return rows;
+		}
+		
+		static void writeRows(ostream &os, const string &title, const vector<Row> &rows, size_t maxRows) {
+			unsigned long long total = 0;
+			for(const Row &row: rows)
+				total += row.count;
+			os << title << endl;
+			for(size_t i=0; i<rows.size() && i<maxRows; i++) {
+				double percent = (total > 0) ? 100.0 * rows[i].count / total : 0.0;
+				os << "  " << setw(12) << rows[i].count << "  " << setw(5) << fixed << setprecision(1) << percent << "%  ";
+				os << rows[i].name << endl;
+			}
+			if(rows.size() > maxRows)
+				os << "  (" << rows.size() - maxRows << " more)" << endl;
+		}
+		
+		static void writeJsonRows(ostream &os, const vector<Row> &rows) {
+			os << '[';
+			for(size_t i=0; i<rows.size(); i++) {
+				os << ((i == 0) ? "" : ", ") << "{\"name\": \"" << rows[i].name << "\", \"count\": " << rows[i].count << '}';
+			}
+			os << ']';
+		}
+	
+	public:
+		//a node about to run
+		void countNode(NodeType type) {
+			nodes[type]++;
+			if(last[0] >= 0) {
+				pairs[last[0]][type]++;
+				if(last[1] >= 0)
+					triples[last[1]][last[0]][type]++;
+			}
+			last[1] = last[0];
+			last[0] = type;
+		}
+		
+		//nodes run so far, of every kind
+		unsigned long long totalNodes() const {
+			unsigned long long total = 0;
+			for(int a=0; a<NUM_NODE_TYPES; a++)
+				total += nodes[a];
+			return total;
+		}
+		
+		//the operand types a + or [] node on line is about to work on
+		void countOperands(const ASTNode* node, DataType left, DataType right) {
+			sites[make_pair(node->lineNum, (int)node->type)].counts[left][right]++;
+		}
+		
+		//sorted tables, the pairs and triples cut to the maxRows most frequent
+		void writeTable(ostream &os, size_t maxRows=20) const {
+			os << "--- opcode stats ---" << endl;
+			writeRows(os, "nodes:", nodeRows(), NUM_NODE_TYPES);
+			writeRows(os, "pairs:", pairRows(), maxRows);
+			writeRows(os, "triples:", tripleRows(), maxRows);
+			os << "operand types:" << endl;
+			for(const pair<const pair<int, int>, OperandSite> &site: sites) {
+				string where = "line " + to_string(site.first.first) + " " + nodeTypeName(site.first.second);
+				where += (site.second.combinations() > 1) ? " (polymorphic)" : "";
+				writeRows(os, "  " + where, operandRows(site.second, site.first.second), NUM_DATA_TYPES * NUM_DATA_TYPES);
+			}
+		}
+		
+		//everything, every row, as one JSON object
+		void writeJson(ostream &os) const {
+			os << "{\"nodes\": ";
+			writeJsonRows(os, nodeRows());
+			os << ", \"pairs\": ";
+			writeJsonRows(os, pairRows());
+			os << ", \"triples\": ";
+			writeJsonRows(os, tripleRows());
+			os << ", \"operands\": [";
+			bool first = true;
+			for(const pair<const pair<int, int>, OperandSite> &site: sites) {
+				os << (first ? "" : ", ") << "{\"line\": " << site.first.first << ", \"node\": \"" << nodeTypeName(site.first.second) << "\", \"types\": ";
+				writeJsonRows(os, operandRows(site.second, site.first.second));
+				os << '}';
+				first = false;
+			}
+			os << "]}" << endl;
+		}
+};
+
+#endif
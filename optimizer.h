@@ -0,0 +1,650 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <set>
+#include "ast.h"
+#include "program.h"
+
+using namespace std;
+
+//whole program passes over a CompiledProgram; they only run once every line
+//is parsed, and only remove work whose absence can't be observed, including
+//through the runtime errors that would have stopped the script
+
+/*====helpers====*/
+//what is known about a variable at a point of the program, from the stores before it
+struct VarFact {
+	DataType type; //INT or LIST
+	int bits; //an INT's magnitude is below 2^bits, so adding two ints under 2^62 can't overflow
+};
+
+//bits of a literal's magnitude (literals are never negative)
+int bitsOf(long long val) {
+	int bits = 0;
+	while(bits < 63 && (val >> bits) != 0)
+		bits++;
+	return bits;
+}
+
+//type an expression certainly evaluates to if it can't fail, D_NIL if it may fail
+VarFact safeValueOf(ASTNode* node, map<string, VarFact> &known) {
+	VarFact unknown = {D_NIL, 64};
+	if(node == nullptr)
+		return unknown;
+	
+	if(node->type == N_Number) {
+		return {INT, bitsOf(node->numVal)};
+	}
+	if(node->type == N_Var) {
+		map<string, VarFact>::iterator it = known.find(node->nodeVal);
+		return (it != known.end()) ? it->second : unknown;
+	}
+	if(node->type == N_List) {
+		for(ASTNode* elem: node->elements) {
+			if(elem->type == N_Number)
+				continue;
+			map<string, VarFact>::iterator it = known.find(elem->nodeVal);
+			if(it == known.end() || it->second.type != INT)
+				return unknown;
+		}
+		return {LIST, 0};
+	}
+	if(node->type == N_Plus) {
+		VarFact l = safeValueOf(node->left, known);
+		VarFact r = safeValueOf(node->right, known);
+		if(l.type == INT && r.type == INT && l.bits < 63 && r.bits < 63)
+			return {INT, max(l.bits, r.bits) + 1};
+		if(l.type == LIST && r.type == LIST)
+			return {LIST, 0};
+		return unknown;
+	}
+	
+	//list access and splices depend on bounds known only at run time
+	return unknown;
+}
+
+//type an expression evaluates to if it succeeds, D_NIL if not known
+VarFact resultOf(ASTNode* node, map<string, VarFact> &known) {
+	VarFact val = safeValueOf(node, known);
+	if(val.type != D_NIL)
+		return val;
+	if(node->type == N_ListAcc)
+		return {INT, 64};
+	if(node->type == N_List || node->type == N_List_Splice)
+		return {LIST, 0};
+	return val;
+}
+
+//adds every variable node reads to names
+void collectReads(ASTNode* node, set<string> &names) {
+	if(node == nullptr)
+		return;
+	if(node->type == N_Var)
+		names.insert(node->nodeVal);
+	for(ASTNode* elem: node->elements)
+		collectReads(elem, names);
+	collectReads(node->left, names);
+	collectReads(node->right, names);
+	collectReads(node->child, names);
+}
+
+bool isVarStore(ASTNode* stmt) {
+	return stmt != nullptr && stmt->type == N_Assign && stmt->left->type == N_Var;
+}
+
+//loops, ifs and blocks aren't looked into; whatever they mention counts as
+//both read and overwritten, and nothing in them is removed
+bool isControlFlow(ASTNode* stmt) {
+	return stmt != nullptr && (stmt->type == N_While || stmt->type == N_For || stmt->type == N_ifStmt || stmt->type == N_Block);
+}
+/*==end helpers==*/
+
+//removes stores to variables that are overwritten or never read afterwards
+//(and so skips building their lists); a store is only removed if evaluating it
+//can't raise an error; with memoryLimited (a --max-memory run) building a list
+//can raise a MemoryError, so stores that build one are kept. With keepGlobals
+//the value each variable ends the program with counts as read, so a host can
+//still fetch it. Returns how many statements were removed; they are left as
+//empty lines to keep line numbers
+size_t eliminateDeadStores(CompiledProgram &program, bool keepGlobals, bool memoryLimited) {
+	vector<ASTNode*> &stmts = program.statements;
+	
+	//forward: which stores can't fail, from the variables certainly bound before them
+	vector<bool> cannotFail(stmts.size(), false);
+	map<string, VarFact> known;
+	for(size_t i=0; i<stmts.size(); i++) {
+		if(isControlFlow(stmts[i])) {
+			set<string> touched;
+			collectReads(stmts[i], touched);
+			for(const string &name: touched)
+				known.erase(name);
+			continue;
+		}
+		if(!isVarStore(stmts[i]))
+			continue;
+		string name = stmts[i]->left->nodeVal;
+		VarFact val = safeValueOf(stmts[i]->right, known);
+		bool buildsList = val.type == LIST && stmts[i]->right->type != N_Var; //a literal or a concatenation, not a shared view
+		cannotFail[i] = (val.type != D_NIL) && !(memoryLimited && buildsList);
+		
+		//later statements only run if this one succeeded
+		val = resultOf(stmts[i]->right, known);
+		if(val.type != D_NIL) {
+			known[name] = val;
+		} else {
+			known.erase(name);
+		}
+	}
+	
+	//backward: liveness
+	set<string> live;
+	if(keepGlobals) {
+		for(ASTNode* stmt: stmts) {
+			if(isVarStore(stmt))
+				live.insert(stmt->left->nodeVal);
+			if(isControlFlow(stmt))
+				collectReads(stmt, live);
+		}
+	}
+	
+	size_t removed = 0;
+	for(size_t i=stmts.size(); i-- > 0;) {
+		ASTNode* stmt = stmts[i];
+		if(stmt == nullptr)
+			continue;
+		
+		if(isVarStore(stmt)) {
+			string name = stmt->left->nodeVal;
+			if(live.count(name) == 0 && cannotFail[i]) {
+				deleteAST(stmts[i]);
+				removed++;
+				continue;
+			}
+			live.erase(name);
+			collectReads(stmt->right, live);
+			continue;
+		}
+		
+		//list element stores and methods update the list in place, so they read it
+		//too; a loop may run its statements any number of times, so nothing it
+		//stores kills a variable
+		collectReads(stmt, live);
+	}
+	
+	program.deadStores += removed;
+	return removed;
+}
+
+/*====type inference====*/
+//types of the variables certainly bound at a point of the program; a name that
+//may be unbound there, or bound to either type, is missing
+typedef map<string, DataType> TypeFacts;
+
+//what holds after either of two paths
+TypeFacts joinFacts(const TypeFacts &a, const TypeFacts &b) {
+	TypeFacts joined;
+	for(const pair<const string, DataType> &fact: a) {
+		TypeFacts::const_iterator it = b.find(fact.first);
+		if(it != b.end() && it->second == fact.second)
+			joined.insert(fact);
+	}
+	return joined;
+}
+
+//type node evaluates to if it doesn't raise an error, D_NIL if not known
+DataType inferredType(ASTNode* node, const TypeFacts &facts) {
+	if(node == nullptr)
+		return D_NIL;
+	switch(node->type) {
+		case N_Number: case N_ListAcc: case N_BoolExpr:
+			return INT;
+		case N_List: case N_List_Splice:
+			return LIST;
+		case N_Call:
+			return node->builtin->result;
+		case N_Var: {
+			TypeFacts::const_iterator it = facts.find(node->nodeVal);
+			return (it != facts.end()) ? it->second : D_NIL;
+		}
+		case N_Plus: {
+			//an int and a list can't be added, so either operand decides
+			DataType l = inferredType(node->left, facts);
+			DataType r = inferredType(node->right, facts);
+			if(l == INT || r == INT)
+				return INT;
+			if(l == LIST || r == LIST)
+				return LIST;
+			return D_NIL;
+		}
+		default:
+			return D_NIL;
+	}
+}
+
+//operand type of a site every time the analysis reached it, D_NIL where any
+//time didn't prove it (a loop body is analyzed until its facts are stable)
+void recordSite(ASTNode* site, DataType proven, map<ASTNode*, DataType> &sites) {
+	pair<map<ASTNode*, DataType>::iterator, bool> it = sites.insert(make_pair(site, proven));
+	if(!it.second && it.first->second != proven)
+		it.first->second = D_NIL;
+}
+
+//variable node bound to a list
+bool isListVar(ASTNode* node, const TypeFacts &facts) {
+	return node != nullptr && node->type == N_Var && inferredType(node, facts) == LIST;
+}
+
+//records the sites of an expression; evaluating one binds no variables, so
+//all of them see the facts from before the statement
+void inferExpression(ASTNode* node, const TypeFacts &facts, map<ASTNode*, DataType> &sites) {
+	if(node == nullptr)
+		return;
+	
+	if(node->type == N_Plus) {
+		DataType l = inferredType(node->left, facts);
+		DataType r = inferredType(node->right, facts);
+		recordSite(node, (l == r) ? l : D_NIL, sites);
+	} else if(node->type == N_ListAcc) {
+		bool proven = isListVar(node->left, facts) && inferredType(node->right, facts) == INT;
+		recordSite(node, proven ? LIST : D_NIL, sites);
+	} else if(node->type == N_List_Splice) {
+		bool proven = isListVar(node->left, facts) && (node->right == nullptr || inferredType(node->right, facts) == INT);
+		recordSite(node, proven ? LIST : D_NIL, sites);
+	} else if(node->type == N_Print1 || node->type == N_Print2) {
+		DataType printed = inferredType((node->type == N_Print1) ? node->child : node->right, facts);
+		recordSite(node, (printed == INT || printed == LIST) ? printed : D_NIL, sites);
+	}
+	
+	for(ASTNode* elem: node->elements)
+		inferExpression(elem, facts, sites);
+	inferExpression(node->left, facts, sites);
+	inferExpression(node->right, facts, sites);
+	inferExpression(node->child, facts, sites);
+}
+
+void inferStatements(const vector<ASTNode*> &stmts, TypeFacts &facts, map<ASTNode*, DataType> &sites);
+
+//records the sites of a statement and updates facts to what holds after it;
+//a statement that raises an error ends the script, so later ones may assume
+//it succeeded
+void inferStatement(ASTNode* stmt, TypeFacts &facts, map<ASTNode*, DataType> &sites) {
+	if(stmt == nullptr)
+		return;
+	
+	if(stmt->type == N_Block) {
+		inferStatements(stmt->elements, facts, sites);
+	} else if(stmt->type == N_ifStmt) {
+		inferExpression(stmt->child, facts, sites);
+		TypeFacts taken = facts;
+		inferStatements(stmt->elements, taken, sites);
+		if(stmt->right != nullptr)
+			inferStatements(stmt->right->elements, facts, sites);
+		facts = joinFacts(taken, facts);
+	} else if(stmt->type == N_While || stmt->type == N_For) {
+		//the facts at the top of the loop: those before it, joined with those
+		//after the body, until that changes nothing
+		if(stmt->type == N_For)
+			inferExpression(stmt->right, facts, sites);
+		TypeFacts entry = facts;
+		TypeFacts head = facts;
+		while(true) {
+			if(stmt->type == N_While)
+				inferExpression(stmt->child, head, sites);
+			TypeFacts body = head;
+			if(stmt->type == N_For)
+				body[stmt->left->nodeVal] = INT;
+			inferStatements(stmt->elements, body, sites);
+			TypeFacts next = joinFacts(entry, body);
+			if(next == head)
+				break;
+			head = next;
+		}
+		facts = head;
+	} else if(stmt->type == N_Assign) {
+		inferExpression(stmt->right, facts, sites);
+		ASTNode* target = stmt->left;
+		if(target->type == N_Var) {
+			DataType type = inferredType(stmt->right, facts);
+			if(type == INT || type == LIST) {
+				facts[target->nodeVal] = type;
+			} else {
+				facts.erase(target->nodeVal);
+			}
+		} else {
+			//l[i] = ... or l[i:] = ...; only the index (or the slice) is evaluated as a node
+			inferExpression((target->type == N_ListAcc) ? target->right : target, facts, sites);
+			facts[target->left->nodeVal] = LIST;
+		}
+	} else if(stmt->type == N_Call && stmt->builtin->style == B_METHOD) {
+		//the receiver is passed as storage, not evaluated
+		for(size_t i=1; i<stmt->elements.size(); i++)
+			inferExpression(stmt->elements[i], facts, sites);
+		facts[stmt->elements[0]->nodeVal] = LIST;
+	} else {
+		inferExpression(stmt, facts, sites);
+	}
+}
+
+void inferStatements(const vector<ASTNode*> &stmts, TypeFacts &facts, map<ASTNode*, DataType> &sites) {
+	for(ASTNode* stmt: stmts)
+		inferStatement(stmt, facts, sites);
+}
+/*==end type inference==*/
+
+//proves the operand types of every +, [], list slice and print it can, flow
+//sensitively from the stores before them, and marks those sites
+//(provenType) so the interpreter skips their type checks. Nothing is known
+//about variables bound before the program starts (a snapshot, an earlier
+//run). Returns how many sites were proven
+size_t inferTypes(CompiledProgram &program) {
+	map<ASTNode*, DataType> sites;
+	TypeFacts facts;
+	inferStatements(program.statements, facts, sites);
+	
+	size_t proven = 0;
+	for(pair<ASTNode* const, DataType> &site: sites) {
+		site.first->provenType = site.second;
+		if(site.second != D_NIL)
+			proven++;
+	}
+	program.typeSites += sites.size();
+	program.typedSites += proven;
+	return proven;
+}
+
+/*====loop invariants====*/
+//a loop being looked at, and every variable its body may write
+struct LoopScope {
+	ASTNode* loop;
+	set<string> written;
+	vector<ASTNode*> invariants; //hoisted to this loop
+};
+
+//adds every variable stmt may write, including in the blocks in it, to names;
+//without elementStores, l[i] = ... (which never changes the length of l) doesn't count
+void collectWrites(ASTNode* stmt, set<string> &names, bool elementStores=true) {
+	if(stmt == nullptr)
+		return;
+	if(stmt->type == N_Assign) {
+		//x = ..., l[i] = ... and l[i:] = ...
+		if(elementStores || stmt->left->type != N_ListAcc)
+			names.insert((stmt->left->type == N_Var) ? stmt->left->nodeVal : stmt->left->left->nodeVal);
+	} else if(stmt->type == N_Call && stmt->builtin->style == B_METHOD) {
+		names.insert(stmt->elements[0]->nodeVal);
+	} else if(stmt->type == N_For) {
+		names.insert(stmt->left->nodeVal);
+	}
+	
+	if(stmt->type == N_While || stmt->type == N_For || stmt->type == N_ifStmt || stmt->type == N_Block) {
+		for(ASTNode* elem: stmt->elements)
+			collectWrites(elem, names, elementStores);
+	}
+	if(stmt->type == N_ifStmt)
+		collectWrites(stmt->right, names, elementStores);
+}
+
+bool isHoistableOperand(ASTNode* node);
+
+//an int expression without side effects worth computing only once: a list
+//read, an addition or comparison, or len(), sum(), min(), max() or abs(), of
+//literals, variables and such expressions
+bool isHoistable(ASTNode* node) {
+	if(node->type == N_ListAcc)
+		return node->left->type == N_Var && isAtom(node->right);
+	if(node->type == N_Plus && node->provenType != LIST)
+		return isHoistableOperand(node->left) && isHoistableOperand(node->right);
+	if(node->type == N_BoolExpr)
+		return isHoistableOperand(node->left) && isHoistableOperand(node->right);
+	if(node->type == N_Call && node->builtin->style == B_FUNCTION && node->builtin->result == INT) {
+		for(ASTNode* arg: node->elements) {
+			if(!isHoistableOperand(arg))
+				return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+bool isHoistableOperand(ASTNode* node) {
+	return isAtom(node) || isHoistable(node);
+}
+
+//hoists the largest invariant expressions in node to the outermost of loops
+//(outermost first) whose body writes none of the variables they read
+void hoistExpression(ASTNode* node, vector<LoopScope*> &loops) {
+	if(node == nullptr || loops.empty())
+		return;
+	if(isHoistable(node)) {
+		set<string> reads;
+		collectReads(node, reads);
+		for(LoopScope* scope: loops) {
+			bool invariant = true;
+			for(const string &name: reads)
+				invariant = invariant && scope->written.count(name) == 0;
+			if(invariant) {
+				scope->invariants.push_back(node);
+				return;
+			}
+		}
+	}
+	
+	for(ASTNode* elem: node->elements)
+		hoistExpression(elem, loops);
+	hoistExpression(node->left, loops);
+	hoistExpression(node->right, loops);
+	hoistExpression(node->child, loops);
+}
+
+void hoistStatements(const vector<ASTNode*> &stmts, vector<LoopScope*> &loops, vector<LoopScope*> &done);
+
+//the invariant expressions of stmt; a loop found in it goes to done
+void hoistStatement(ASTNode* stmt, vector<LoopScope*> &loops, vector<LoopScope*> &done) {
+	if(stmt == nullptr)
+		return;
+	
+	if(stmt->type == N_While || stmt->type == N_For) {
+		if(stmt->type == N_For)
+			hoistExpression(stmt->right, loops); //evaluated once per run of the loop
+		LoopScope* scope = new LoopScope();
+		scope->loop = stmt;
+		collectWrites(stmt, scope->written);
+		loops.push_back(scope);
+		hoistExpression(stmt->child, loops); //the condition of a while
+		hoistStatements(stmt->elements, loops, done);
+		loops.pop_back();
+		done.push_back(scope);
+	} else if(stmt->type == N_ifStmt) {
+		hoistExpression(stmt->child, loops);
+		hoistStatements(stmt->elements, loops, done);
+		if(stmt->right != nullptr)
+			hoistStatements(stmt->right->elements, loops, done);
+	} else if(stmt->type == N_Block) {
+		hoistStatements(stmt->elements, loops, done);
+	} else if(stmt->type == N_Assign) {
+		//the target is a variable or the list being written, never invariant
+		hoistExpression(stmt->right, loops);
+	} else if(stmt->type == N_Call && stmt->builtin->style == B_METHOD) {
+		for(size_t i=1; i<stmt->elements.size(); i++)
+			hoistExpression(stmt->elements[i], loops);
+	} else {
+		hoistExpression(stmt, loops);
+	}
+}
+
+void hoistStatements(const vector<ASTNode*> &stmts, vector<LoopScope*> &loops, vector<LoopScope*> &done) {
+	for(ASTNode* stmt: stmts)
+		hoistStatement(stmt, loops, done);
+}
+/*==end loop invariants==*/
+
+//finds the expressions in loops (while and for) that read only variables
+//their loop doesn't write, and gives each a slot in ctx.invariants: each is
+//computed once per run of the outermost loop it is invariant in, and reused
+//until that loop starts again. The value is computed where the expression
+//first runs, not before the loop, so a loop that never reaches it doesn't
+//compute it, and one that raises an error evaluating it raises it at the same
+//point. Returns how many expressions were hoisted
+size_t hoistLoopInvariants(CompiledProgram &program) {
+	vector<LoopScope*> loops;
+	vector<LoopScope*> done;
+	hoistStatements(program.statements, loops, done);
+	
+	size_t hoisted = 0;
+	for(LoopScope* scope: done) {
+		scope->loop->firstInvariant = program.invariantSlots + hoisted;
+		scope->loop->numInvariants = scope->invariants.size();
+		for(ASTNode* node: scope->invariants)
+			node->invariantSlot = program.invariantSlots + hoisted++;
+		delete scope;
+	}
+	program.invariantSlots += hoisted;
+	return hoisted;
+}
+
+/*====bounds checks====*/
+//a counted loop: its index, and the lists its body may change the length of
+struct CountedLoop {
+	ASTNode* loop;
+	string index;
+	set<string> resized; //assigned, spliced, appended to or looped over
+	map<string, vector<ASTNode*> > accesses; //list name -> l[index] in the body
+};
+
+//adds every l[index] in node (an expression or statement, and the blocks in
+//it) to the accesses of loop, unless l may be resized or is the index
+void collectIndexing(ASTNode* node, CountedLoop &loop) {
+	if(node == nullptr)
+		return;
+	if(node->type == N_ListAcc && node->left->type == N_Var && node->right->type == N_Var && node->right->nodeVal == loop.index) {
+		const string &lst = node->left->nodeVal;
+		if(lst != loop.index && loop.resized.count(lst) == 0)
+			loop.accesses[lst].push_back(node);
+	}
+	for(ASTNode* elem: node->elements)
+		collectIndexing(elem, loop);
+	collectIndexing(node->left, loop);
+	collectIndexing(node->right, loop);
+	collectIndexing(node->child, loop);
+}
+
+//i = i + k, k an int literal: an increment that keeps i an int and never lowers it
+bool isIncrementOf(ASTNode* stmt, const string &index) {
+	if(stmt == nullptr || stmt->fused != F_IncVar || stmt->left->nodeVal != index)
+		return false;
+	ASTNode* addend = addendOf(stmt->right, stmt->left);
+	return addend->type == N_Number;
+}
+
+//the counted loop stmt is, false if it isn't one:
+//for i in range(...): with i not assigned in the body; every l[i] in it is
+//within l if the range is, which is checked once when the loop starts
+//while i < len(l): with i written only by increments at the top of the body;
+//every l[i] before the first increment is within l if i >= 0 when the loop starts
+bool countedLoop(ASTNode* stmt, CountedLoop &loop) {
+	loop.loop = stmt;
+	set<string> written;
+	for(ASTNode* elem: stmt->elements) {
+		collectWrites(elem, written);
+		collectWrites(elem, loop.resized, false);
+	}
+	
+	if(stmt->type == N_For) {
+		loop.index = stmt->left->nodeVal;
+		if(stmt->right->type != N_Call || stmt->right->builtin->fn != builtinRange || written.count(loop.index) != 0)
+			return false;
+		for(ASTNode* elem: stmt->elements)
+			collectIndexing(elem, loop);
+		return true;
+	}
+	
+	ASTNode* cond = stmt->child;
+	if(cond->type != N_BoolExpr || cond->nodeVal != "<" || cond->left->type != N_Var || cond->right->type != N_Call)
+		return false;
+	ASTNode* bound = cond->right;
+	if(bound->builtin->fn != builtinLen || bound->elements[0]->type != N_Var)
+		return false;
+	loop.index = cond->left->nodeVal;
+	
+	//the statements before the first increment see i < len(l)
+	size_t firstIncrement = stmt->elements.size();
+	for(size_t i=0; i<stmt->elements.size(); i++) {
+		ASTNode* elem = stmt->elements[i];
+		if(isIncrementOf(elem, loop.index)) {
+			if(firstIncrement == stmt->elements.size())
+				firstIncrement = i;
+			continue;
+		}
+		set<string> elemWrites;
+		collectWrites(elem, elemWrites);
+		if(elemWrites.count(loop.index) != 0)
+			return false;
+	}
+	for(size_t i=0; i<firstIncrement; i++)
+		collectIndexing(stmt->elements[i], loop);
+	
+	//only the list the condition bounds i by
+	const string &lst = bound->elements[0]->nodeVal;
+	map<string, vector<ASTNode*> > bounded;
+	if(loop.accesses.count(lst) != 0)
+		bounded[lst] = loop.accesses[lst];
+	loop.accesses.swap(bounded);
+	return true;
+}
+
+void findCountedLoops(const vector<ASTNode*> &stmts, vector<CountedLoop> &loops) {
+	for(ASTNode* stmt: stmts) {
+		if(stmt == nullptr)
+			continue;
+		if(stmt->type == N_While || stmt->type == N_For) {
+			CountedLoop loop;
+			if(countedLoop(stmt, loop) && !loop.accesses.empty())
+				loops.push_back(loop);
+		}
+		if(stmt->type == N_While || stmt->type == N_For || stmt->type == N_ifStmt || stmt->type == N_Block)
+			findCountedLoops(stmt->elements, loops);
+		if(stmt->type == N_ifStmt && stmt->right != nullptr)
+			findCountedLoops(stmt->right->elements, loops);
+	}
+}
+/*==end bounds checks==*/
+
+//finds the list reads and element stores l[i] in counted loops (for i in
+//range(...) and while i < len(l) with i = i + k increments) that can only be
+//in bounds, and drops their per iteration bounds check: l's length can't
+//change in the loop, so whether every i the loop takes is within l is checked
+//once when the loop starts, into a slot of ctx.inBounds. If it isn't, or l
+//isn't a list then, each access is checked as usual and raises the same
+//error. Returns how many accesses it found
+size_t eliminateBoundsChecks(CompiledProgram &program) {
+	vector<CountedLoop> loops;
+	findCountedLoops(program.statements, loops);
+	
+	size_t sites = 0;
+	for(CountedLoop &loop: loops) {
+		loop.loop->firstBoundsSlot = program.boundsSlots;
+		for(pair<const string, vector<ASTNode*> > &lst: loop.accesses) {
+			loop.loop->boundedLists.push_back(lst.second[0]->left);
+			for(ASTNode* acc: lst.second) {
+				acc->boundsSlot = program.boundsSlots;
+				sites++;
+			}
+			program.boundsSlots++;
+		}
+	}
+	program.uncheckedSites += sites;
+	return sites;
+}
+
+//every pass, in order; inferTypes() follows the passes that may remove the
+//stores it reasons about, and hoistLoopInvariants() uses the types it proved
+void optimizeProgram(CompiledProgram &program, bool keepGlobals, bool memoryLimited) {
+	eliminateDeadStores(program, keepGlobals, memoryLimited);
+	inferTypes(program);
+	hoistLoopInvariants(program);
+	eliminateBoundsChecks(program);
+}
+
+#endif
\ No newline at end of file
@@ -3,24 +3,76 @@
 
 #include <iostream>
 #include <vector>
-#include <stack>
-#include <queue>
-#include <map>
-#include <utility>
+#include <charconv>
 #include "tokens.h"
 #include "ast.h"
-#include "global_scope.h"
+#include "builtins.h"
 #include "error.h"
 #include "DebugFuncs.h"
 
 using namespace std;
 
+/*====operator table====*/
+//binding power of each infix token, higher binds tighter; operators whose node
+//the interpreter can't evaluate yet are listed but not enabled, so they are
+//rejected exactly like any other token that can't follow an operand
+struct InfixOperator {
+	int precedence; //0 if the token is not an infix operator
+	NodeType node;
+	bool enabled;
+};
+
+constexpr InfixOperator infixOperator(TokenType t) {
+	switch(t) {
+		case T_Less: case T_Greater: case T_EQ: case T_Not: return {10, N_BoolExpr, true}; //see comparator()
+		case T_Plus: return {20, N_Plus, true};
+		case T_Minus: return {20, N_NILNode, false};
+		case T_Mult: case T_Div: return {30, N_NILNode, false};
+		default: return {0, N_NILNode, false};
+	}
+}
+/*==end operator table==*/
+
+//single pass predictive parser: every production is chosen from the current
+//token (list subscripts are left factored, so a[i] and a[i:] share a prefix);
+//nothing is ever re-scanned, so parsing is linear in the number of tokens
+//
+//  line        ::= (END ENDL)* statement? ENDL (END ENDL)* EOF?
+//  statement   ::= assign | print | call | header
+//  header      ::= ("while" expr | "if" expr | "else" | "for" IDENTIFIER "in" arg) ":"
+//  assign      ::= IDENTIFIER "=" (list | list_splice | expr)
+//               |  list_acc "=" expr
+//               |  list_splice "=" list_splice
+//  print       ::= "print" "(" (str_lit ",")? operand ")"
+//  expr        ::= operand (("+" | comparator) operand)*    (precedence climbing)
+//  comparator  ::= "<" | ">" | "<=" | ">=" | "==" | "!="
+//  operand     ::= INT | IDENTIFIER | list_acc | call | "(" expr ")"
+//  call        ::= BUILTIN "(" (arg ("," arg)*)? ")" | IDENTIFIER "." BUILTIN "(" (arg ("," arg)*)? ")"
+//  arg         ::= (operand | list | list_splice) ("+" operand)*
+//  list        ::= "[" (atom ("," atom)*)? "]"
+//  list_acc    ::= IDENTIFIER "[" atom "]"
+//  list_splice ::= IDENTIFIER "[" atom? ":" "]"
+//  atom        ::= INT | IDENTIFIER
+//
+//a header opens a block holding the statements of the following lines, up to
+//the END ENDL pair the lexer emits where the block is dedented; a finished
+//if is held back until the next statement of its block shows it has no else
 class Parser {
 	private:
 		vector<Token> tokens;
 		int tok_idx;
 		Token currTok;
 		ASTNode* tree = nullptr;
+		vector<ASTNode*> statementNodes; //every node of the statement being parsed
+		
+		//a block being parsed; its header's nodes are out of statementNodes
+		struct BlockLevel {
+			ASTNode* header; //while, for or if node; nullptr for the top level
+			bool isElse; //the else block of header
+			vector<ASTNode*> body;
+			ASTNode* pendingIf; //last statement, if it may still get an else
+		};
+		vector<BlockLevel> levels = {{nullptr, false, {}, nullptr}}; //innermost last
 		
 		//advances to next token
 		void nextToken() {
@@ -31,698 +83,634 @@ class Parser {
 				currTok.TokenCopy(Token(T_NONE, "", -1, -1));
 			}
 		}
-		//sets currTok to token at specific index
-		void setCurrTokIndex(int i) {
-			if(i < tokens.size()) {
-				tok_idx = i;
-				currTok.TokenCopy(tokens[tok_idx]);
-			} else {
-				currTok.TokenCopy(Token(T_NONE, "", -1, -1));
-			}
+		//type of the token after currTok
+		TokenType peekToken() {
+			if(tok_idx + 1 < tokens.size())
+				return tokens[tok_idx + 1].token_type;
+			return T_NONE;
 		}
-		//raise syntax error
+		//raise syntax error, freeing the partially built statement
 		void raiseSyntaxError(string txt, int lineNumber, ErrType errTypeOverride=InvalidSyntaxError) {
-			deleteAST(tree);
-			//cout << "AT ERROR: current token is " << representToken(currTok) << " at token pos " << tok_idx << endl;
+			for(ASTNode* n: statementNodes)
+				delete n;
+			statementNodes.clear();
+			for(BlockLevel &level: levels) {
+				for(ASTNode* &stmt: level.body)
+					deleteAST(stmt);
+				deleteAST(level.pendingIf);
+				deleteAST(level.header);
+			}
+			levels.assign(1, {nullptr, false, {}, nullptr});
+			tree = nullptr;
 			RaiseError(errTypeOverride, txt, lineNumber);
 		}
+		//allocates a node of the current statement
+		ASTNode* newNode(NodeType type) {
+			ASTNode* node = new ASTNode(type, currTok.tok_lineNum);
+			statementNodes.push_back(node);
+			return node;
+		}
 		
-		//modified shunting yard algorithm
-		queue<ASTNode*> shuntingYardAlgo(vector<ASTNode*> inNodeList) {
-			stack<ASTNode*> operatorStack;
-			queue<ASTNode*> outputQueue;
-			
-			for(ASTNode* node: inNodeList) {
-				if(node->type == N_Var || node->type == N_Number || node->type == N_ListAcc) {
-					outputQueue.push(node);
+		ASTNode* newVarNode(string name, DataType type) {
+			ASTNode* varNode_ast = newNode(N_Var);
+			varNode_ast->init_varNode(name, type, nullptr);
+			return varNode_ast;
+		}
+		
+		//atom ::= INT|IDENTIFIER, the current token must be one of them
+		ASTNode* atom() {
+			ASTNode* atom_ast = nullptr;
+			if(currTok.token_type == T_INT) {
+				const string &digits = currTok.token_value;
+				long long val = 0;
+				if(from_chars(digits.data(), digits.data() + digits.size(), val).ec != errc()) {
+					raiseSyntaxError("integer that fits in 64 bits", currTok.tok_lineNum);
 				}
-				
-				if(node->type == N_Plus) {
-					operatorStack.push(node);
+				atom_ast = newNode(N_Number);
+				atom_ast->init_numNode(digits, val);
+			} else {
+				atom_ast = newVarNode(currTok.token_value, D_NIL);
+			}
+			nextToken();
+			return atom_ast;
+		}
+		
+		//IDENTIFIER "[" atom "]" (list_acc) or IDENTIFIER "[" atom? ":" "]" (list_splice),
+		//current token is the identifier and the next one "["; returns nullptr if it
+		//is neither, without raising, as what that means depends on the caller
+		ASTNode* subscript() {
+			string listName = currTok.token_value;
+			nextToken(); //"["
+			nextToken(); //should be ":" or atom
+			
+			ASTNode* index_ast = nullptr;
+			if(currTok.token_type == T_INT || (currTok.token_type == T_Identifier && peekToken() != T_OpenBracket)) {
+				index_ast = atom();
+			} else if(currTok.token_type != T_Colon) {
+				return nullptr;
+			}
+			
+			//list_splice
+			if(currTok.token_type == T_Colon) {
+				nextToken(); //should be "]"
+				if(currTok.token_type != T_CloseBracket) {
+					raiseSyntaxError("']'", currTok.tok_lineNum);
 				}
+				ASTNode* lstSpliceNode_ast = newNode(N_List_Splice);
+				lstSpliceNode_ast->init_listSpliceNode(newVarNode(listName, LIST), index_ast, (index_ast != nullptr) ? "T" : "F");
+				nextToken();
+				return lstSpliceNode_ast;
 			}
 			
-			while(!operatorStack.empty()) {
-				outputQueue.push(operatorStack.top());
-				operatorStack.pop();
+			//list_acc
+			if(currTok.token_type == T_CloseBracket) {
+				ASTNode* lstAcc_ast = newNode(N_ListAcc);
+				lstAcc_ast->init_listAccessNode(newVarNode(listName, LIST), index_ast);
+				nextToken();
+				return lstAcc_ast;
 			}
 			
-			return outputQueue;
+			return nullptr;
 		}
 		
-	public:
-		//initialization
-		void initialize(vector<Token> inTokenList) {
-			//deleteAST(tree);
-			tokens = inTokenList;
-			tok_idx = -1;
-			nextToken();
+		//number of arguments a builtin takes, for error messages
+		string arityText(const Builtin* fn) {
+			if(fn->maxArgs == fn->minArgs)
+				return to_string(fn->minArgs) + ((fn->minArgs == 1) ? " argument" : " arguments");
+			if(fn->maxArgs < 0)
+				return "at least " + to_string(fn->minArgs) + " argument" + ((fn->minArgs == 1) ? "" : "s");
+			return to_string(fn->minArgs) + " to " + to_string(fn->maxArgs) + " arguments";
 		}
 		
-		//syntax analysis and AST creation
-		void parseAndCreateAST() {
-			//empty or comment
-			if(currTok.token_type == T_EndLine && tokens.size() == 1) {
-				tree = nullptr;
-				nextToken();
+		//arg ::= (operand | list | list_splice) ("+" operand)*
+		ASTNode* argument() {
+			ASTNode* arg_ast = nullptr;
+			if(currTok.token_type == T_OpenBracket) {
+				arg_ast = getList();
+			} else if(currTok.token_type == T_Identifier && peekToken() == T_OpenBracket) {
+				arg_ast = subscript();
+			} else {
+				arg_ast = operand();
+			}
+			if(arg_ast == nullptr) {
+				raiseSyntaxError("either integer, identifier, list, or list access", currTok.tok_lineNum);
 			}
+			return exprRest(arg_ast, 1);
+		}
+		
+		//"(" (arg ("," arg)*)? ")" of a call to fn, after receiver_ast if it is a method
+		ASTNode* callArguments(string name, const Builtin* fn, ASTNode* receiver_ast) {
+			ASTNode* callNode_ast = newNode(N_Call);
+			nextToken(); //"("
+			nextToken(); //should be either arg or ")"
 			
-			//Identifier; check for assignment
-			if(currTok.token_type == T_Identifier) {
-				tree = assign(tok_idx);
-				
-				if(tree->type == N_NILNode) {
-					raiseSyntaxError("different syntax for identifier", currTok.tok_lineNum);
+			vector<ASTNode*> args;
+			if(receiver_ast != nullptr)
+				args.push_back(receiver_ast);
+			if(currTok.token_type != T_CloseParen) {
+				args.push_back(argument());
+				while(currTok.token_type == T_Comma) {
+					nextToken(); //should be arg
+					args.push_back(argument());
+				}
+				if(currTok.token_type != T_CloseParen) {
+					raiseSyntaxError("',' or ')'", currTok.tok_lineNum);
 				}
-				
-				nextToken();
 			}
 			
-			//TODO: keyword; check for print
-			if(currTok.token_type == T_Keyword) {
-				//print
-				if(currTok.token_value == "print") {
-					tree = printOneOrTwo(tok_idx);
-					
-					if(tree->type == N_NILNode) {
-						raiseSyntaxError("different syntax for print()", currTok.tok_lineNum);
-					}
-				
-					nextToken();
-				}
-				
-				//error
-				else {
-					raiseSyntaxError("different syntax for keyword " + currTok.token_value, currTok.tok_lineNum);
+			int numArgs = args.size() - ((receiver_ast != nullptr) ? 1 : 0);
+			if(numArgs < fn->minArgs || (fn->maxArgs >= 0 && numArgs > fn->maxArgs)) {
+				raiseSyntaxError(arityText(fn) + " for " + name + "()", currTok.tok_lineNum);
+			}
+			
+			callNode_ast->init_callNode(name, fn, args);
+			nextToken();
+			return callNode_ast;
+		}
+		
+		//call ::= BUILTIN "(" ... ")" | IDENTIFIER "." BUILTIN "(" ... ")", current token is
+		//the function name (followed by "(") or the receiver (followed by ".")
+		ASTNode* call() {
+			//method
+			if(peekToken() == T_Dot) {
+				ASTNode* receiver_ast = newVarNode(currTok.token_value, LIST);
+				nextToken(); //"."
+				nextToken(); //should be method name
+				const Builtin* fn = (currTok.token_type == T_Identifier) ? lookupBuiltin(currTok.token_value) : nullptr;
+				if(fn == nullptr || fn->style != B_METHOD || peekToken() != T_OpenParen) {
+					raiseSyntaxError("list method call", currTok.tok_lineNum);
 				}
+				return callArguments(currTok.token_value, fn, receiver_ast);
 			}
 			
-			//error
-			if(currTok.token_type != T_NONE) {
-				raiseSyntaxError("different syntax", currTok.tok_lineNum);
+			//function
+			const Builtin* fn = lookupBuiltin(currTok.token_value);
+			if(fn == nullptr) {
+				raiseSyntaxError("builtin function instead of '" + currTok.token_value + "'", currTok.tok_lineNum);
 			}
+			if(fn->style != B_FUNCTION) {
+				raiseSyntaxError("list." + currTok.token_value + "()", currTok.tok_lineNum);
+			}
+			return callArguments(currTok.token_value, fn, nullptr);
 		}
 		
-		ASTNode* getAST() {
-			return tree;
+		//a name that isn't a builtin followed by "(" isn't a call, so it gets the
+		//error it always did ("expected =" as a statement)
+		bool atCall() {
+			if(currTok.token_type == T_Identifier && peekToken() == T_Dot)
+				return true;
+			bool name = currTok.token_type == T_Identifier || currTok.token_type == T_Keyword;
+			return name && peekToken() == T_OpenParen && lookupBuiltin(currTok.token_value) != nullptr;
 		}
 		
-		//function for atom ::= INT|IDENTIFIER
-		ASTNode* atom(int backTrackIdx) {
+		//operand ::= INT | IDENTIFIER | list_acc | call | "(" expr ")"; returns nullptr if there is none
+		ASTNode* operand() {
 			if(currTok.token_type == T_INT) {
-				ASTNode* numNode_ast = new ASTNode(N_Number, currTok.tok_lineNum);
-				numNode_ast->init_numNode(currTok.token_value);
+				return atom();
+			}
+			if(currTok.token_type == T_OpenParen) {
+				nextToken(); //should be operand
+				ASTNode* inner_ast = operand();
+				if(inner_ast == nullptr) {
+					raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
+				}
+				inner_ast = exprRest(inner_ast, 1);
+				if(currTok.token_type != T_CloseParen) {
+					raiseSyntaxError("')'", currTok.tok_lineNum);
+				}
 				nextToken();
-				return numNode_ast;
+				return inner_ast;
+			}
+			if(atCall()) {
+				return call();
 			}
-			
 			if(currTok.token_type == T_Identifier) {
-				ASTNode* varNode_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-				varNode_ast->init_varNode(currTok.token_value, D_NIL, nullptr);
-				nextToken();
-				if(currTok.token_type == T_OpenBracket) {
-					delete varNode_ast;
-					ASTNode* failNode_ast = new ASTNode(N_NILNode);
-					setCurrTokIndex(backTrackIdx);
-					return failNode_ast;
+				if(peekToken() != T_OpenBracket) {
+					return atom();
+				}
+				ASTNode* sub_ast = subscript();
+				if(sub_ast != nullptr && sub_ast->type == N_ListAcc) {
+					return sub_ast;
 				}
-				return varNode_ast;
 			}
-			
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			return nullptr;
 		}
 		
-		//function for list_access ::= IDENTIFIER "[" atom "]"
-		ASTNode* list_acc(int backTrackIdx) {
-			if(currTok.token_type == T_Identifier) {
-				int idtIdx = tok_idx; //store index of list var
-				nextToken(); //should be open bracket
-				if(currTok.token_type == T_OpenBracket) {
-					nextToken(); //should be atom
-					ASTNode* listIndex_ast = atom(tok_idx);
-					
-					//if atom fails, raise error
-					if(listIndex_ast->type == N_NILNode) {
-						delete listIndex_ast;
-						//raiseSyntaxError("either int or identifier", currTok.tok_lineNum);
-						ASTNode* failNode_ast = new ASTNode(N_NILNode);
-						setCurrTokIndex(backTrackIdx);
-						return failNode_ast;
-					}
-					
-					//nextToken(); //should be closed bracket
-					if(currTok.token_type == T_CloseBracket) {
-						ASTNode* lstVar_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-						Token temp = tokens[idtIdx];
-						lstVar_ast->init_varNode(temp.token_value, LIST, nullptr);
-						
-						ASTNode* lstAcc_ast = new ASTNode(N_ListAcc, currTok.tok_lineNum);
-						lstAcc_ast->init_listAccessNode(lstVar_ast, listIndex_ast);
-						nextToken();
-						return lstAcc_ast;
-					} else {
-						//raise error
-						delete listIndex_ast;
-						//raiseSyntaxError("']'", currTok.tok_lineNum);
-						ASTNode* failNode_ast = new ASTNode(N_NILNode);
-						setCurrTokIndex(backTrackIdx);
-						return failNode_ast;
-					}
-					
+		//comparison operator starting at currTok, "" if there is none; the lexer
+		//only makes one character tokens, so "<=", "==" and "!=" are two of them,
+		//which count only when nothing separates them, and a lone "=" or "!" is
+		//not an operator
+		string comparator() {
+			TokenType t = currTok.token_type;
+			bool eqFollows = peekToken() == T_EQ && tokens[tok_idx + 1].tok_pos == currTok.tok_pos + 1;
+			if(t == T_Less || t == T_Greater)
+				return currTok.token_value + (eqFollows ? "=" : "");
+			if((t == T_EQ || t == T_Not) && eqFollows)
+				return currTok.token_value + "=";
+			return "";
+		}
+		
+		//whether currTok starts an enabled operator binding at least minPrecedence
+		bool atOperator(int minPrecedence) {
+			InfixOperator op = infixOperator(currTok.token_type);
+			if(!op.enabled || op.precedence < minPrecedence)
+				return false;
+			return op.node != N_BoolExpr || comparator() != "";
+		}
+		
+		//precedence climbing over infixOperator(); left operand already parsed.
+		//a < b < c is rejected: python would chain it into a < b and b < c, not
+		//compare the result of a < b with c
+		ASTNode* exprRest(ASTNode* left_ast, int minPrecedence) {
+			bool compared = false;
+			while(atOperator(minPrecedence)) {
+				InfixOperator op = infixOperator(currTok.token_type);
+				if(op.node == N_BoolExpr && compared) {
+					raiseSyntaxError("one comparison per expression, chained comparisons are not supported", currTok.tok_lineNum);
+				}
+				compared = compared || op.node == N_BoolExpr;
+				ASTNode* opNode_ast = newNode(op.node);
+				string cmp = (op.node == N_BoolExpr) ? comparator() : "";
+				if(cmp.size() == 2) {
+					nextToken();
+				}
+				nextToken();
+				ASTNode* right_ast = operand();
+				if(right_ast == nullptr) {
+					raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
+				}
+				
+				//bind tighter operators to the right operand first
+				if(atOperator(op.precedence + 1)) {
+					right_ast = exprRest(right_ast, op.precedence + 1);
+				}
+				
+				if(op.node == N_BoolExpr) {
+					opNode_ast->init_boolExprNode(left_ast, cmp, right_ast);
 				} else {
-					//not list access
-					ASTNode* failNode_ast = new ASTNode(N_NILNode);
-					setCurrTokIndex(backTrackIdx);
-					return failNode_ast;
+					opNode_ast->init_plusNode(left_ast, right_ast);
 				}
+				left_ast = opNode_ast;
 			}
-			
-			//not list access
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			return left_ast;
 		}
 		
-		//function for list spluce ::= IDENTIFIER "[" atom^ ":" "]" 
-		ASTNode* list_splice(int backTrackIdx) {
-			if(currTok.token_type == T_Identifier) {
-				int idtIdx = tok_idx;
-				nextToken(); //should be open bracket
-				if(currTok.token_type == T_OpenBracket) {
-					nextToken(); //should be either (INT|IDENTIFIER) or ":"
-					
-					//if ":"
-					if(currTok.token_type == T_Colon) {
-						nextToken(); //should be close brackets
-						if(currTok.token_type == T_CloseBracket) {
-							Token temp = tokens[idtIdx];
-							ASTNode* lstVarNode_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-							lstVarNode_ast->init_varNode(temp.token_value, LIST, nullptr);
-							
-							ASTNode* lstSpliceNode_ast = new ASTNode(N_List_Splice, currTok.tok_lineNum);
-							lstSpliceNode_ast->init_listSpliceNode(lstVarNode_ast, nullptr, "F");
-							
-							nextToken();
-							return lstSpliceNode_ast;
-						} else {
-							//raise error
-							raiseSyntaxError("']'", currTok.tok_lineNum);
-						}
-					}
-					
-					//if (INT|IDENTIFIER)
-					if(currTok.token_type == T_INT || currTok.token_type == T_Identifier) {
-						ASTNode* spliceValNode_ast = nullptr;
-						if(currTok.token_type == T_INT) {
-							spliceValNode_ast = new ASTNode(N_Number, currTok.tok_lineNum);
-							spliceValNode_ast->init_numNode(currTok.token_value);
-						} else if(currTok.token_type == T_Identifier) {
-							spliceValNode_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-							spliceValNode_ast->init_varNode(currTok.token_value, D_NIL, nullptr);
-						}
-						
-						nextToken(); //should be ":"
-						if(currTok.token_type == T_Colon) {
-							nextToken(); //should be "]"
-							if(currTok.token_type == T_CloseBracket) {
-								Token temp = tokens[idtIdx];
-								ASTNode* lstVarNode_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-								lstVarNode_ast->init_varNode(temp.token_value, LIST, nullptr);
-								
-								ASTNode* lstSpliceNode_ast = new ASTNode(N_List_Splice, currTok.tok_lineNum);
-								lstSpliceNode_ast->init_listSpliceNode(lstVarNode_ast, spliceValNode_ast, "T");
-								
-								nextToken();
-								return lstSpliceNode_ast;
-							} else {
-								//raise error
-								raiseSyntaxError("']'", currTok.tok_lineNum);
-							}
-						} 
-					}
-				}
+		//an expression must end the line; only "+" can follow an operand
+		ASTNode* exprFrom(ASTNode* left_ast) {
+			ASTNode* expr_ast = exprRest(left_ast, 1);
+			if(currTok.token_type != T_EndLine) {
+				raiseSyntaxError("'+'", currTok.tok_lineNum);
 			}
-			
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			return expr_ast;
 		}
 		
-		//fucntion for expression ::= (atom|list_acc) ("+" (atom|list_acc))*
-		ASTNode* expr(int backTrackIdx) {
-			vector<ASTNode*> nodeExprLst;
-			ASTNode* resExpr_ast = nullptr;
-			ASTNode* leftOp_ast = atom(tok_idx);
-			
-			//check if not atom
-			if(leftOp_ast->type == N_NILNode) {
-				delete leftOp_ast;
-				leftOp_ast = list_acc(tok_idx);
+		ASTNode* newAssignNode(ASTNode* left_ast, ASTNode* right_ast) {
+			ASTNode* assignNode_ast = newNode(N_Assign);
+			assignNode_ast->init_assignNode(left_ast, right_ast);
+			return assignNode_ast;
+		}
+		
+		/*====blocks====*/
+		//an if whose block is closed waits for a possible else
+		void flushPendingIf(BlockLevel &level) {
+			if(level.pendingIf != nullptr) {
+				level.body.push_back(level.pendingIf);
+				level.pendingIf = nullptr;
+			}
+		}
+		
+		//appends a complete statement to the innermost block
+		void addStatement(ASTNode* stmt) {
+			BlockLevel &level = levels.back();
+			flushPendingIf(level);
+			if(stmt->type == N_ifStmt && stmt->right == nullptr) {
+				level.pendingIf = stmt;
+			} else {
+				level.body.push_back(stmt);
+			}
+		}
+		
+		//the lexer emitted END ENDL: the innermost block is complete
+		void closeBlock() {
+			if(levels.size() == 1) {
+				raiseSyntaxError("different syntax", currTok.tok_lineNum);
+			}
+			flushPendingIf(levels.back());
+			BlockLevel level = levels.back();
+			levels.pop_back();
+			if(level.body.empty()) {
+				levels.push_back(level); //freed with the other open blocks
+				raiseSyntaxError("an indented block", currTok.tok_lineNum);
 			}
 			
-			//if also not list access raise error
-			if(leftOp_ast->type == N_NILNode) {
-				delete resExpr_ast;
-				delete leftOp_ast;
+			if(level.isElse) {
+				ASTNode* elseBlock = new ASTNode(N_Block, level.header->lineNum);
+				elseBlock->init_blockNode(level.body);
+				level.header->right = elseBlock;
+			} else {
+				level.header->elements = level.body;
+			}
+			addStatement(level.header);
+		}
+		
+		void closeEndedBlocks() {
+			while(currTok.token_type == T_StatementEnd) {
+				nextToken(); //ENDL
+				nextToken();
+				closeBlock();
+			}
+		}
+		
+		//expr of a while or if header, which the ":" must follow
+		ASTNode* condition() {
+			nextToken(); //should be expr
+			ASTNode* cond_ast = operand();
+			if(cond_ast == nullptr) {
 				raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
 			}
+			return exprRest(cond_ast, 1);
+		}
+		
+		//":" ending a header, which opens a block
+		void openBlock(ASTNode* header, bool isElse) {
+			if(currTok.token_type != T_Colon) {
+				raiseSyntaxError("':'", currTok.tok_lineNum);
+			}
+			nextToken();
+			statementNodes.clear(); //the open block owns header now
+			levels.push_back({header, isElse, {}, nullptr});
+		}
+		
+		//"for" IDENTIFIER "in" arg ":"
+		void forHeader() {
+			nextToken(); //should be the loop variable
+			if(currTok.token_type != T_Identifier) {
+				raiseSyntaxError("identifier", currTok.tok_lineNum);
+			}
+			ASTNode* var_ast = newVarNode(currTok.token_value, INT);
+			nextToken(); //should be "in"
+			if(currTok.token_type != T_Keyword || currTok.token_value != "in") {
+				raiseSyntaxError("'in'", currTok.tok_lineNum);
+			}
+			nextToken(); //should be the iterable
+			ASTNode* iterable_ast = argument();
 			
-			//if only single assignment
-			if(currTok.token_type == T_EndLine) {
-				setCurrTokIndex(tok_idx-1);
-				nextToken();
-				return leftOp_ast;
+			ASTNode* forNode_ast = newNode(N_For);
+			forNode_ast->init_forNode(var_ast, iterable_ast, {});
+			openBlock(forNode_ast, false);
+		}
+		
+		//statement ::= assign | print | call | header
+		void statement() {
+			//builtin call whose result is unused, e.g. l.append(1)
+			if(atCall()) {
+				addStatement(call());
 			}
 			
-			//expression
-			nodeExprLst.push_back(leftOp_ast);
-			if(currTok.token_type == T_Plus) {
-				int i = 1;
-				while(currTok.token_type == T_Plus && currTok.token_type != T_NONE) {
-					//create empty (uninitialized) plus node
-					nodeExprLst.push_back(new ASTNode(N_Plus, currTok.tok_lineNum));
-					nextToken();
-					i+=1;
-					
-					//get right node (atom|list_acc)
-					nodeExprLst.push_back(atom(tok_idx));
-					//if not atom
-					if(nodeExprLst[i]->type == N_NILNode) {
-						delete nodeExprLst[i];
-						nodeExprLst.pop_back();
-						nodeExprLst.push_back(list_acc(tok_idx));
-					}
-					
-					//if also not list_acc; raise error
-					if(nodeExprLst[i]->type == N_NILNode) {
-						delete resExpr_ast;
-						delete leftOp_ast;
-						delete nodeExprLst[i];
-						nodeExprLst.pop_back();
-					} else {
-						i+=1;
-						continue;
+			//Identifier; assignment
+			else if(currTok.token_type == T_Identifier) {
+				addStatement(assign());
+			}
+			
+			//keyword; print or a block header
+			else if(currTok.token_type == T_Keyword) {
+				if(currTok.token_value == "print") {
+					addStatement(printOneOrTwo());
+				} else if(currTok.token_value == "while") {
+					ASTNode* whileNode_ast = newNode(N_While);
+					whileNode_ast->init_whileNode(condition(), {});
+					openBlock(whileNode_ast, false);
+				} else if(currTok.token_value == "if") {
+					ASTNode* ifNode_ast = newNode(N_ifStmt);
+					ifNode_ast->init_ifStmtNode(condition(), {});
+					openBlock(ifNode_ast, false);
+				} else if(currTok.token_value == "for") {
+					forHeader();
+				} else if(currTok.token_value == "else" && levels.back().pendingIf != nullptr) {
+					ASTNode* ifNode_ast = levels.back().pendingIf;
+					nextToken(); //should be ":"
+					if(currTok.token_type == T_Colon) {
+						levels.back().pendingIf = nullptr;
 					}
-					
-					//add both to nodeExprLst
-					i+=1;
-					nextToken();
+					openBlock(ifNode_ast, true);
+				}
+				
+				//error
+				else {
+					raiseSyntaxError("different syntax for keyword " + currTok.token_value, currTok.tok_lineNum);
 				}
-			} else {
-				//raise error
-				delete resExpr_ast;
-				delete leftOp_ast;
-				raiseSyntaxError("'+'", currTok.tok_lineNum);
 			}
 			
-			//check if very last element of list isn't a plus, if plus -> raise error
-			if(nodeExprLst[nodeExprLst.size()-1]->type == N_Plus) {
-				for(ASTNode* n: nodeExprLst)
-					delete n;
-				delete resExpr_ast;
-				delete leftOp_ast;
-				raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
+			else {
+				raiseSyntaxError("different syntax", currTok.tok_lineNum);
 			}
+			statementNodes.clear();
+		}
+		/*==end blocks==*/
+	
+	public:
+		//initialization
+		void initialize(vector<Token> inTokenList) {
+			//the previous tree is owned by the interpreter now
+			tree = nullptr;
+			statementNodes.clear();
+			tokens = inTokenList;
+			tok_idx = -1;
+			nextToken();
+		}
+		
+		//syntax analysis and AST creation; the tree holds the statements this line
+		//completed, which may be none (an empty line, or one inside a block), a
+		//whole loop once its block is closed, or several in a block node
+		void parseAndCreateAST() {
+			tree = nullptr;
+			closeEndedBlocks();
 			
-			//apply modified shunting yard algorithm
-			queue<ASTNode*> postfix_ast = shuntingYardAlgo(nodeExprLst);
-			
-			//apply postfix evaluation (based on image)
-			queue<ASTNode*> treeQueue;
-			stack<ASTNode*> operandStack;
-			while(!postfix_ast.empty()) {
-				//if operand
-				if(postfix_ast.front()->type == N_Var || postfix_ast.front()->type == N_Number || postfix_ast.front()->type == N_ListAcc) {
-					operandStack.push(postfix_ast.front());
-					postfix_ast.pop();
-				}
-				
-				//if operator
-				if(postfix_ast.front()->type == N_Plus) {
-					//if tree queue is empty
-					if(treeQueue.empty()) {
-						postfix_ast.front()->init_plusNode(nullptr, operandStack.top());
-						operandStack.pop();
-						postfix_ast.front()->left = operandStack.top();
-						operandStack.pop();
-						treeQueue.push(postfix_ast.front());
-					}
-					
-					//if tree queue is not empty
-					else {
-						postfix_ast.front()->init_plusNode(operandStack.top(), treeQueue.front());
-						operandStack.pop();
-						treeQueue.pop();
-						treeQueue.push(postfix_ast.front());
-					}
-					
-					postfix_ast.pop();
+			//the statement must take up the whole line
+			if(currTok.token_type != T_EndLine && currTok.token_type != T_EOF) {
+				statement();
+				if(currTok.token_type != T_EndLine) {
+					raiseSyntaxError("different syntax", currTok.tok_lineNum);
 				}
 			}
+			if(currTok.token_type == T_EndLine) {
+				nextToken();
+			}
+			closeEndedBlocks();
 			
-			//check if tree queue has size 1, if so return tree else return false node
-			if(treeQueue.size() == 1) {
+			//nothing can follow an else any more
+			if(currTok.token_type == T_EOF) {
+				flushPendingIf(levels.front());
 				nextToken();
-				return treeQueue.front();
-			} else {
-				for(ASTNode* n: nodeExprLst)
-					delete n;
-				if(!treeQueue.empty()) {
-					while(!treeQueue.empty()) {
-						delete treeQueue.front();
-						treeQueue.pop();
-					}
-				}
-				
-				delete resExpr_ast;
-				delete leftOp_ast;
+			}
+			if(currTok.token_type != T_NONE) {
+				raiseSyntaxError("different syntax", currTok.tok_lineNum);
 			}
 			
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			vector<ASTNode*> &done = levels.front().body;
+			if(done.size() == 1) {
+				tree = done[0];
+			} else if(done.size() > 1) {
+				tree = new ASTNode(N_Block, done[0]->lineNum);
+				tree->init_blockNode(done);
+			}
+			done.clear();
+			if(tree != nullptr) {
+				tree->stackDepth = computeStackDepth(tree);
+				fuseSuperinstructions(tree);
+			}
+		}
+		
+		ASTNode* getAST() {
+			return tree;
+		}
+		
+		//function for expression ::= operand ("+" operand)*
+		ASTNode* expr() {
+			ASTNode* left_ast = operand();
+			if(left_ast == nullptr) {
+				raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
+			}
+			return exprFrom(left_ast);
 		}
 		
 		//function for list ::= "[" atom ("," atom)* "]" | "[" "]"
-		ASTNode* getList(int backTrackIdx) {
-			vector<string> list_ast;
-			if(currTok.token_type == T_OpenBracket) {
-				nextToken(); //should be either atom or closded bracket
-				
-				//empty list
-				if(currTok.token_type == T_CloseBracket) {
-					ASTNode* lstNode_ast = new ASTNode(N_List, currTok.tok_lineNum);
-					lstNode_ast->init_listNode(list_ast);
-					nextToken();
-					return lstNode_ast;
+		//identifiers are kept as var nodes and resolved by the interpreter, so the
+		//parser never reads the symbol table and can run ahead of execution
+		ASTNode* getList() {
+			vector<ASTNode*> list_ast;
+			nextToken(); //should be either atom or closed bracket
+			
+			if(currTok.token_type != T_CloseBracket) {
+				if(currTok.token_type != T_INT && currTok.token_type != T_Identifier) {
+					raiseSyntaxError("integer or variable", currTok.tok_lineNum);
 				}
+				list_ast.push_back(atom());
 				
-				//not empty list
-				if(currTok.token_type == T_INT || currTok.token_type == T_Identifier) {
-					if(currTok.token_type == T_INT) {
-						list_ast.push_back(currTok.token_value);
-					} else if(currTok.token_type == T_Identifier) {
-						if(symbolTable.find(currTok.token_value) != symbolTable.end()) {
-							if(symbolTable[currTok.token_value].second == INT) {
-								list_ast.push_back(symbolTable[currTok.token_value].first);
-							} else {
-								//raise invalid type error
-								string errMsg = ", lists may only contain ints or int variables, multiple dimensions are not supported";
-								raiseSyntaxError(errMsg, currTok.tok_lineNum, RunTimeError);
-							}
-						} else {
-							//raise error
-							string errMsg = ", \'" + currTok.token_value + "\' not defined";
-							raiseSyntaxError(errMsg, currTok.tok_lineNum, RunTimeError);
-						}
-					}
-					
-					nextToken(); //should be comma or close bracket
-					while(currTok.token_type != T_CloseBracket && currTok.token_type != T_NONE) {
-						if(currTok.token_type == T_Comma) {
-							nextToken(); //should be INT|IDENTIFIER
-							if(currTok.token_type == T_INT || currTok.token_type == T_Identifier) {
-								if(currTok.token_type == T_INT) {
-									list_ast.push_back(currTok.token_value);
-								} else if(currTok.token_type == T_Identifier) {
-									if(symbolTable.find(currTok.token_value) != symbolTable.end()) {
-										if(symbolTable[currTok.token_value].second == INT) {
-											list_ast.push_back(symbolTable[currTok.token_value].first);
-										} else {
-											//raise invalid type error
-											string errMsg = ", lists may only contain ints or int variables, multiple dimensions are not supported";
-											raiseSyntaxError(errMsg, currTok.tok_lineNum, RunTimeError);
-										}
-									} else {
-										//raise error
-										string errMsg = ", \'" + currTok.token_value + "\' not defined";
-										raiseSyntaxError(errMsg, currTok.tok_lineNum, RunTimeError);
-									}
-								}
-							}
-						} else {
-							//raise error
-							raiseSyntaxError("','", currTok.tok_lineNum);
-						}
-						
-						nextToken();
-					}
-					
-					//if list is complete return node
-					if(currTok.token_type == T_CloseBracket) {
-						ASTNode* lstNode_ast = new ASTNode(N_List, currTok.tok_lineNum);
-						lstNode_ast->init_listNode(list_ast);
-						nextToken();
-						return lstNode_ast;
-					} else {
-						//raise error
+				while(currTok.token_type == T_Comma) {
+					nextToken(); //should be INT|IDENTIFIER
+					if(currTok.token_type == T_INT || currTok.token_type == T_Identifier) {
+						list_ast.push_back(atom());
+					} else if(currTok.token_type == T_EndLine) {
 						raiseSyntaxError("']'", currTok.tok_lineNum);
+					} else {
+						raiseSyntaxError("','", currTok.tok_lineNum);
 					}
-				} else {
-					//raise error
-					raiseSyntaxError("integer or variable", currTok.tok_lineNum);
+				}
+				
+				if(currTok.token_type != T_CloseBracket) {
+					raiseSyntaxError("','", currTok.tok_lineNum);
 				}
 			}
 			
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			ASTNode* lstNode_ast = newNode(N_List);
+			lstNode_ast->init_listNode(list_ast);
+			nextToken();
+			return lstNode_ast;
 		}
 		
 		//function for assign ::= (IDENTIFIER "=" expr | list | list_splice) | (list_acc "=" expr) | (list_splice "=" list_splice)
-		ASTNode* assign(int backTrackIdx) {
-			ASTNode* toBeAssignNode_ast = list_acc(tok_idx);
-			ASTNode* rightHandSideNode_ast = nullptr;
-			ASTNode* assignNode_ast = nullptr;
-			
-			//is list access
-			if(toBeAssignNode_ast->type != N_NILNode) {
-				//nextToken(); //should be "="
-				if(currTok.token_type == T_EQ) {
-					nextToken(); //should be expr
-					
-					rightHandSideNode_ast = expr(tok_idx);
-					if(rightHandSideNode_ast->type != N_NILNode) {
-						//assign
-						assignNode_ast = new ASTNode(N_Assign, currTok.tok_lineNum);
-						assignNode_ast->init_assignNode(toBeAssignNode_ast, rightHandSideNode_ast);
-						nextToken();
-						return assignNode_ast;
-					} else {
-						//raise error
-						delete toBeAssignNode_ast;
-						delete rightHandSideNode_ast;
-						delete assignNode_ast;
-						raiseSyntaxError("expression", currTok.tok_lineNum);
-					}
-				} else {
-					//raise error
+		ASTNode* assign() {
+			//list_acc or list_splice on the left
+			if(peekToken() == T_OpenBracket) {
+				ASTNode* target_ast = subscript();
+				if(target_ast == nullptr) {
 					raiseSyntaxError("=", currTok.tok_lineNum);
 				}
-			} 
-			
-			//checking for list splice
-			if(toBeAssignNode_ast->type == N_NILNode) {
-				delete toBeAssignNode_ast;
-				toBeAssignNode_ast = list_splice(tok_idx);
-			}
-			
-			//is list splice
-			if(toBeAssignNode_ast->type == N_List_Splice) {
-				//nextToken() already called
-				if(currTok.token_type == T_EQ) {
-					nextToken(); //should be list splice
-					rightHandSideNode_ast = list_splice(tok_idx);
-					
-					if(rightHandSideNode_ast->type == N_NILNode) {
-						//raise error
-						delete toBeAssignNode_ast;
-						delete rightHandSideNode_ast;
-						delete assignNode_ast;
-						raiseSyntaxError("list splice", currTok.tok_lineNum);
-					} else {
-						assignNode_ast = new ASTNode(N_Assign, currTok.tok_lineNum);
-						assignNode_ast->init_assignNode(toBeAssignNode_ast, rightHandSideNode_ast);
-						nextToken();
-						return assignNode_ast;
+				
+				//list_acc "=" expr
+				if(target_ast->type == N_ListAcc) {
+					if(currTok.token_type != T_EQ) {
+						raiseSyntaxError("=", currTok.tok_lineNum);
 					}
-				} else {
-					//raise error
-					delete toBeAssignNode_ast;
-					delete rightHandSideNode_ast;
-					delete assignNode_ast;
+					nextToken(); //should be expr
+					return newAssignNode(target_ast, expr());
+				}
+				
+				//list_splice "=" list_splice
+				if(currTok.token_type != T_EQ) {
 					raiseSyntaxError("'='", currTok.tok_lineNum);
 				}
+				nextToken(); //should be list splice
+				ASTNode* source_ast = nullptr;
+				if(currTok.token_type == T_Identifier && peekToken() == T_OpenBracket) {
+					source_ast = subscript();
+				}
+				if(source_ast == nullptr || source_ast->type != N_List_Splice) {
+					raiseSyntaxError("list splice", currTok.tok_lineNum);
+				}
+				return newAssignNode(target_ast, source_ast);
 			}
 			
-			//is not list access or splice / is identifier
-			if(toBeAssignNode_ast->type == N_NILNode) {
-				delete toBeAssignNode_ast;
-				if(currTok.token_type == T_Identifier) {
-					toBeAssignNode_ast = new ASTNode(N_Var, currTok.tok_lineNum);
-					toBeAssignNode_ast->init_varNode(currTok.token_value, D_NIL, nullptr);
-					nextToken(); //should be "eq"
-					
-					if(currTok.token_type == T_EQ) {
-						nextToken(); //should be either expr or list
-						//if list
-						if(currTok.token_type == T_OpenBracket) {
-							toBeAssignNode_ast->dataType = LIST;
-							rightHandSideNode_ast = getList(tok_idx);
-							
-							if(rightHandSideNode_ast->type != N_NILNode) {
-								//assign
-								assignNode_ast = new ASTNode(N_Assign, currTok.tok_lineNum);
-								assignNode_ast->init_assignNode(toBeAssignNode_ast, rightHandSideNode_ast);
-								nextToken();
-								return assignNode_ast;
-							} else {
-								//raise error
-								delete toBeAssignNode_ast;
-								delete rightHandSideNode_ast;
-								delete assignNode_ast;
-								raiseSyntaxError("list", currTok.tok_lineNum);
-							}
-						}
-						
-						//if not list
-						else {
-							rightHandSideNode_ast = list_splice(tok_idx);
-							if(rightHandSideNode_ast->type == N_NILNode) {
-								delete rightHandSideNode_ast;
-							} else if(rightHandSideNode_ast->type == N_List_Splice) {
-								assignNode_ast = new ASTNode(N_Assign, currTok.tok_lineNum);
-								assignNode_ast->init_assignNode(toBeAssignNode_ast, rightHandSideNode_ast);
-								nextToken();
-								return assignNode_ast;
-							}
-							
-							rightHandSideNode_ast = expr(tok_idx);
-							if(rightHandSideNode_ast->type != N_NILNode) {
-								//assign
-								assignNode_ast = new ASTNode(N_Assign, currTok.tok_lineNum);
-								assignNode_ast->init_assignNode(toBeAssignNode_ast, rightHandSideNode_ast);
-								nextToken();
-								return assignNode_ast;
-							} else {
-								//raise error
-								raiseSyntaxError("expression or list splice", currTok.tok_lineNum);
-							}
-						}
-					} else {
-						//raise error
-						raiseSyntaxError("=", currTok.tok_lineNum);
-					}
-					
-				} else {
-					//raise error
-					raiseSyntaxError("expression or list", currTok.tok_lineNum);
+			//IDENTIFIER "=" ...
+			ASTNode* target_ast = newVarNode(currTok.token_value, D_NIL);
+			nextToken(); //should be "="
+			if(currTok.token_type != T_EQ) {
+				raiseSyntaxError("=", currTok.tok_lineNum);
+			}
+			nextToken(); //should be either expr, list or list splice
+			
+			//list
+			if(currTok.token_type == T_OpenBracket) {
+				target_ast->dataType = LIST;
+				return newAssignNode(target_ast, getList());
+			}
+			
+			//list_splice, or a list_acc starting an expression
+			if(currTok.token_type == T_Identifier && peekToken() == T_OpenBracket) {
+				ASTNode* sub_ast = subscript();
+				if(sub_ast == nullptr) {
+					raiseSyntaxError("either integer, identifier, or list access", currTok.tok_lineNum);
 				}
+				if(sub_ast->type == N_List_Splice) {
+					return newAssignNode(target_ast, sub_ast);
+				}
+				return newAssignNode(target_ast, exprFrom(sub_ast));
 			}
 			
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			return newAssignNode(target_ast, expr());
 		}
 		
-		//function for print ::= "print" "(" (atom|list_acc) ")" || "print" "(" str_lit "," (atom|list_acc) ")"
-		ASTNode* printOneOrTwo(int backTrackIdx) {
-			ASTNode* printNode_ast = nullptr;
+		//function for print ::= "print" "(" operand ")" || "print" "(" str_lit "," operand ")"
+		ASTNode* printOneOrTwo() {
+			nextToken(); //should be "("
+			if(currTok.token_type != T_OpenParen) {
+				raiseSyntaxError("'('", currTok.tok_lineNum);
+			}
+			nextToken(); //should be either string literal or operand
 			
-			if(currTok.token_value == "print") {
-				nextToken(); //should be "("
-				if(currTok.token_type == T_OpenParen) {
-					nextToken(); //should be either string literal or (atom|list_acc)
+			//"print" "(" str_lit "," operand ")"
+			ASTNode* strLit_ast = nullptr;
+			if(currTok.token_type == T_String_Literal) {
+				strLit_ast = newNode(N_StrLtr);
+				strLit_ast->init_strLtrNode(currTok.token_value);
 				
-					//string literal
-					// "print" "(" str_lit "," (atom|list_acc) ")"
-					if(currTok.token_type == T_String_Literal) {
-						ASTNode* strLit_ast = new ASTNode(N_StrLtr, currTok.tok_lineNum);
-						strLit_ast->init_strLtrNode(currTok.token_value);
-						
-						nextToken(); //should be comma
-						if(currTok.token_type == T_Comma) {
-							nextToken(); //should be (atom|list_acc)
-							
-							ASTNode* printValNode_ast = atom(tok_idx);
-							if(printValNode_ast->type == N_NILNode) {
-								delete printValNode_ast;
-								printValNode_ast = list_acc(tok_idx);
-							}
-							
-							if(printValNode_ast->type == N_NILNode) {
-								delete printNode_ast;
-								delete strLit_ast;
-								delete printValNode_ast;
-								raiseSyntaxError("identifier, number or list access", currTok.tok_lineNum);
-							}
-							
-							//next token called inside atom() and/or list_acc()
-							if(currTok.token_type == T_CloseParen) {
-								//return true
-								printNode_ast = new ASTNode(N_Print2, currTok.tok_lineNum);
-								printNode_ast->init_printTwo(strLit_ast, printValNode_ast);
-								nextToken();
-								return printNode_ast;
-							} else {
-								//raise error
-								delete printNode_ast;
-								delete strLit_ast;
-								delete printValNode_ast;
-								raiseSyntaxError("')'", currTok.tok_lineNum);
-							}
-							
-						} else {
-							//raise error
-							delete printNode_ast;
-							delete strLit_ast;
-							raiseSyntaxError("','", currTok.tok_lineNum);
-						}
-					}
-					
-					//if not string literal
-					else {
-						ASTNode* printValNode_ast = atom(tok_idx);
-						if(printValNode_ast->type == N_NILNode) {
-							delete printValNode_ast;
-							printValNode_ast = list_acc(tok_idx);
-						}
-						
-						if(printValNode_ast->type == N_NILNode) {
-							delete printNode_ast;
-							delete printValNode_ast;
-							raiseSyntaxError("identifier, number or list access", currTok.tok_lineNum);
-						}
-						
-						//next token called inside atom() and/or list_acc()
-						if(currTok.token_type == T_CloseParen) {
-							//return true
-							printNode_ast = new ASTNode(N_Print1, currTok.tok_lineNum);
-							printNode_ast->init_printOne(printValNode_ast);
-							nextToken();
-							return printNode_ast;
-						} else {
-							//raise error
-							delete printNode_ast;
-							raiseSyntaxError("')'", currTok.tok_lineNum);
-						}
-					}
-				} else {
-					//raise error
-					delete printNode_ast;
-					raiseSyntaxError("'('", currTok.tok_lineNum);
+				nextToken(); //should be comma
+				if(currTok.token_type != T_Comma) {
+					raiseSyntaxError("','", currTok.tok_lineNum);
 				}
+				nextToken(); //should be operand
+			}
+			
+			ASTNode* printValNode_ast = operand();
+			if(printValNode_ast == nullptr) {
+				raiseSyntaxError("identifier, number or list access", currTok.tok_lineNum);
+			}
+			if(currTok.token_type != T_CloseParen) {
+				raiseSyntaxError("')'", currTok.tok_lineNum);
 			}
 			
-			delete printNode_ast;
-			ASTNode* failNode_ast = new ASTNode(N_NILNode);
-			setCurrTokIndex(backTrackIdx);
-			return failNode_ast;
+			ASTNode* printNode_ast = nullptr;
+			if(strLit_ast != nullptr) {
+				printNode_ast = newNode(N_Print2);
+				printNode_ast->init_printTwo(strLit_ast, printValNode_ast);
+			} else {
+				printNode_ast = newNode(N_Print1);
+				printNode_ast->init_printOne(printValNode_ast);
+			}
+			nextToken();
+			return printNode_ast;
 		}
-		
-		//if statement
 };
 
 #endif
\ No newline at end of file
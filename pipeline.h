@@ -0,0 +1,217 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "tokens.h"
+#include "lexer.h"
+#include "parser.h"
+#include "ast.h"
+#include "interpreter.h"
+#include "error.h"
+
+using namespace std;
+
+//bounded lock-free single-producer/single-consumer ring buffer
+template <typename T>
+class SPSCQueue {
+	private:
+		vector<T> buffer;
+		size_t mask;
+		alignas(64) atomic<size_t> head; //next slot to read, owned by the consumer
+		alignas(64) atomic<size_t> tail; //next slot to write, owned by the producer
+	
+	public:
+		SPSCQueue(size_t capacity) {
+			//round capacity up to a power of two so wrapping is a mask
+			size_t cap = 2;
+			while(cap < capacity)
+				cap <<= 1;
+			buffer.resize(cap);
+			mask = cap - 1;
+			head.store(0);
+			tail.store(0);
+		}
+		
+		bool tryPush(T &item) {
+			size_t t = tail.load(memory_order_relaxed);
+			if(t - head.load(memory_order_acquire) == buffer.size())
+				return false; //full
+			buffer[t & mask] = move(item);
+			tail.store(t + 1, memory_order_release);
+			return true;
+		}
+		
+		bool tryPop(T &item) {
+			size_t h = head.load(memory_order_relaxed);
+			if(h == tail.load(memory_order_acquire))
+				return false; //empty
+			item = move(buffer[h & mask]);
+			head.store(h + 1, memory_order_release);
+			return true;
+		}
+		
+		//spins until there is room, gives up if the pipeline is cancelled
+		bool push(T item, atomic<bool> &cancelled) {
+			while(!tryPush(item)) {
+				if(cancelled.load(memory_order_relaxed))
+					return false;
+				this_thread::yield();
+			}
+			return true;
+		}
+		
+		//spins until an item is available, gives up if the pipeline is cancelled
+		bool pop(T &item, atomic<bool> &cancelled) {
+			while(!tryPop(item)) {
+				if(cancelled.load(memory_order_relaxed))
+					return false;
+				this_thread::yield();
+			}
+			return true;
+		}
+};
+
+//one lexed line, or the error that stopped the lexer
+struct TokenBatch {
+	vector<Token> tokens;
+	bool isEnd = false;
+	bool isError = false;
+	string errMsg;
+};
+
+//one parsed line, or the error that stopped the lexer/parser
+struct ParsedLine {
+	ASTNode* tree = nullptr;
+	bool isEnd = false;
+	bool isError = false;
+	string errMsg;
+};
+
+//runs lexing, parsing and execution on three threads connected by SPSC queues;
+//front end errors travel down the pipeline as items, so they are raised only once
+//every line before them has executed, the same order as the sequential loop
+class PipelinedRunner {
+	private:
+		SPSCQueue<TokenBatch> tokenQueue;
+		SPSCQueue<ParsedLine> astQueue;
+		atomic<bool> cancelled;
+		
+		void lexStage(istream &inputProgram) {
+			LexicalAnalyzer lexer;
+			string line;
+			int lineCtr = 1;
+			
+			while(getline(inputProgram, line)) {
+				TokenBatch batch;
+				try {
+					lexer.initialize(line, lineCtr);
+					lexer.tokenize();
+					if(inputProgram.peek() == EOF) {
+						lexer.addEndStmntTokenIfNecessary(true);
+					}
+					batch.tokens = lexer.getTokens();
+				} catch(CreateProgramError &e) {
+					batch.isError = true;
+					batch.errMsg = e.errMsg;
+					tokenQueue.push(batch, cancelled);
+					return;
+				}
+				
+				if(!tokenQueue.push(batch, cancelled))
+					return;
+				lineCtr++;
+			}
+			
+			TokenBatch endBatch;
+			endBatch.isEnd = true;
+			tokenQueue.push(endBatch, cancelled);
+		}
+		
+		void parseStage() {
+			Parser parse;
+			
+			while(true) {
+				TokenBatch batch;
+				if(!tokenQueue.pop(batch, cancelled))
+					return;
+				
+				ParsedLine parsed;
+				parsed.isEnd = batch.isEnd;
+				parsed.isError = batch.isError;
+				parsed.errMsg = batch.errMsg;
+				
+				if(!batch.isEnd && !batch.isError) {
+					try {
+						parse.initialize(batch.tokens);
+						parse.parseAndCreateAST();
+						parsed.tree = parse.getAST();
+					} catch(CreateProgramError &e) {
+						parsed.isError = true;
+						parsed.errMsg = e.errMsg;
+					}
+				}
+				
+				if(!astQueue.push(parsed, cancelled)) {
+					deleteAST(parsed.tree);
+					return;
+				}
+				if(parsed.isEnd || parsed.isError)
+					return;
+			}
+		}
+	
+	public:
+		PipelinedRunner(size_t queueCapacity=256) : tokenQueue(queueCapacity), astQueue(queueCapacity) {
+			cancelled.store(false);
+		}
+		
+		//executes the program in ctx; throws CreateProgramError like the sequential loop
+		void run(istream &inputProgram, InterpreterContext &ctx) {
+			thread lexThread(&PipelinedRunner::lexStage, this, ref(inputProgram));
+			thread parseThread(&PipelinedRunner::parseStage, this);
+			
+			Interpreter interpret(ctx);
+			string errMsg;
+			bool failed = false;
+			
+			while(true) {
+				ParsedLine parsed;
+				astQueue.pop(parsed, cancelled);
+				
+				if(parsed.isEnd)
+					break;
+				if(parsed.isError) {
+					failed = true;
+					errMsg = parsed.errMsg;
+					break;
+				}
+				
+				try {
+					interpret.initialize(parsed.tree);
+					interpret.evaluate();
+				} catch(CreateProgramError &e) {
+					failed = true;
+					errMsg = e.errMsg;
+					break;
+				}
+			}
+			
+			//stop the front end and free whatever it already produced
+			cancelled.store(true);
+			parseThread.join();
+			lexThread.join();
+			ParsedLine leftover;
+			while(astQueue.tryPop(leftover))
+				deleteAST(leftover.tree);
+			TokenBatch leftoverBatch;
+			while(tokenQueue.tryPop(leftoverBatch)) {}
+			
+			if(failed)
+				throw CreateProgramError(errMsg);
+		}
+};
+
+#endif
\ No newline at end of file
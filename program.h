@@ -0,0 +1,89 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <iostream>
+#include <vector>
+#include "tokens.h"
+#include "lexer.h"
+#include "parser.h"
+#include "ast.h"
+#include "global_scope.h"
+#include "interpreter.h"
+#include "error.h"
+
+using namespace std;
+
+//a whole script lexed and parsed up front, so it can be executed any number of
+//times; parsing never depends on runtime state, so this is equivalent to the
+//line by line loop as long as a front end error is raised at the same point
+struct CompiledProgram {
+	vector<ASTNode*> statements; //one tree per line, nullptr for empty lines
+	bool hasError = false; //front end error right after the last statement
+	string errMsg;
+	size_t deadStores = 0; //statements removed by eliminateDeadStores()
+	size_t typeSites = 0; //+, [], list slices and prints, as counted by inferTypes()
+	size_t typedSites = 0; //those whose operand types it proved
+	size_t invariantSlots = 0; //loop invariants hoisted by hoistLoopInvariants()
+	size_t boundsSlots = 0; //lists counted loops index unchecked, by eliminateBoundsChecks()
+	size_t uncheckedSites = 0; //list accesses it removed the bounds check of
+	
+	CompiledProgram() {}
+	CompiledProgram(const CompiledProgram&) = delete;
+	CompiledProgram& operator=(const CompiledProgram&) = delete;
+	
+	~CompiledProgram() {
+		for(ASTNode* &stmt: statements) {
+			deleteAST(stmt);
+		}
+	}
+};
+
+//lexes and parses the whole program, stopping at the first error
+CompiledProgram* compileProgram(istream &inputProgram) {
+	CompiledProgram* program = new CompiledProgram();
+	LexicalAnalyzer lexer;
+	Parser parse;
+	
+	string line;
+	int lineCtr = 1;
+	try {
+		while(getline(inputProgram, line)) {
+			lexer.initialize(line, lineCtr);
+			lexer.tokenize();
+			if(inputProgram.peek() == EOF) {
+				lexer.addEndStmntTokenIfNecessary(true);
+			}
+			
+			parse.initialize(lexer.getTokens());
+			parse.parseAndCreateAST();
+			program->statements.push_back(parse.getAST());
+			
+			lineCtr++;
+		}
+	}
+	
+	catch(CreateProgramError& e) {
+		program->hasError = true;
+		program->errMsg = e.errMsg;
+	}
+	
+	return program;
+}
+
+//runs a compiled program in ctx; throws CreateProgramError like runProgram
+void executeProgram(CompiledProgram &program, InterpreterContext &ctx) {
+	Interpreter interpret(ctx);
+	if(ctx.invariants.size() < program.invariantSlots)
+		ctx.invariants.resize(program.invariantSlots);
+	if(ctx.inBounds.size() < program.boundsSlots)
+		ctx.inBounds.resize(program.boundsSlots);
+	ctx.memoEpoch++; //nodes cached by an earlier run may have been freed and reused
+	for(ASTNode* stmt: program.statements) {
+		interpret.execute(stmt);
+	}
+	
+	if(program.hasError)
+		throw CreateProgramError(program.errMsg);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,368 @@
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include "scan.h"
+
+using namespace std;
+
+//reductions of int lists behind sum(), min(), max(), any() and all(): each
+//block of the list goes through a vectorized kernel (chosen by scanLevel, like
+//the lexer's scans), and a long list is split into contiguous parts reduced on
+//the threads of a pool kept for the whole process, whose results are combined
+//in list order, so the result never depends on the number of threads
+
+const size_t REDUCE_BLOCK = 4096; //elements a sum kernel adds up in 64 bits
+const size_t PARALLEL_REDUCE_MIN = 1 << 20; //shorter lists are reduced on the calling thread
+const size_t PARALLEL_REDUCE_PART = 1 << 18; //fewest elements a thread gets
+
+atomic<unsigned> reduceThreads{thread::hardware_concurrency()}; //can be lowered, e.g. by benchmarks, while scripts run
+
+/*====scalar====*/
+//wrapping sum of a block, and the OR of the magnitudes of its elements
+//(x ^ (x >> 63) is |x| for x >= 0 and |x| - 1 below), which bounds them
+long long blockSumScalar(const long long* nums, size_t count, unsigned long long &magnitudes) {
+	unsigned long long sum = 0;
+	unsigned long long mag = 0;
+	for(size_t i=0; i<count; i++) {
+		sum += (unsigned long long)nums[i];
+		mag |= (unsigned long long)(nums[i] ^ (nums[i] >> 63));
+	}
+	magnitudes = mag;
+	return (long long)sum;
+}
+
+long long minScalar(const long long* nums, size_t count) {
+	long long best = nums[0];
+	for(size_t i=1; i<count; i++)
+		best = (nums[i] < best) ? nums[i] : best;
+	return best;
+}
+
+long long maxScalar(const long long* nums, size_t count) {
+	long long best = nums[0];
+	for(size_t i=1; i<count; i++)
+		best = (nums[i] > best) ? nums[i] : best;
+	return best;
+}
+
+//whether any element is nonzero
+bool anyScalar(const long long* nums, size_t count) {
+	for(size_t i=0; i<count; i++) {
+		if(nums[i] != 0)
+			return true;
+	}
+	return false;
+}
+
+//whether every element is nonzero
+bool allScalar(const long long* nums, size_t count) {
+	for(size_t i=0; i<count; i++) {
+		if(nums[i] == 0)
+			return false;
+	}
+	return true;
+}
+/*==end scalar==*/
+
+#ifdef SCAN_X86
+/*====AVX2====*/
+//the 4 lanes of v added up, wrapping
+__attribute__((target("avx2")))
+long long laneSum(__m256i v) {
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, v);
+	return (long long)((unsigned long long)lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+__attribute__((target("avx2")))
+long long blockSumAVX2(const long long* nums, size_t count, unsigned long long &magnitudes) {
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i sum = zero;
+	__m256i mag = zero;
+	size_t i = 0;
+	for(; i + 4 <= count; i += 4) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(nums + i));
+		sum = _mm256_add_epi64(sum, chunk);
+		mag = _mm256_or_si256(mag, _mm256_xor_si256(chunk, _mm256_cmpgt_epi64(zero, chunk)));
+	}
+	unsigned long long tailMag = 0;
+	long long tail = blockSumScalar(nums + i, count - i, tailMag);
+	long long lanesOr[4];
+	_mm256_storeu_si256((__m256i*)lanesOr, mag);
+	magnitudes = (unsigned long long)(lanesOr[0] | lanesOr[1] | lanesOr[2] | lanesOr[3]) | tailMag;
+	return (long long)((unsigned long long)laneSum(sum) + tail);
+}
+
+__attribute__((target("avx2")))
+long long minAVX2(const long long* nums, size_t count) {
+	if(count < 4)
+		return minScalar(nums, count);
+	__m256i best = _mm256_loadu_si256((const __m256i*)nums);
+	size_t i = 4;
+	for(; i + 4 <= count; i += 4) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(nums + i));
+		best = _mm256_blendv_epi8(best, chunk, _mm256_cmpgt_epi64(best, chunk));
+	}
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, best);
+	long long result = minScalar(lanes, 4);
+	return (i < count) ? min(result, minScalar(nums + i, count - i)) : result;
+}
+
+__attribute__((target("avx2")))
+long long maxAVX2(const long long* nums, size_t count) {
+	if(count < 4)
+		return maxScalar(nums, count);
+	__m256i best = _mm256_loadu_si256((const __m256i*)nums);
+	size_t i = 4;
+	for(; i + 4 <= count; i += 4) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(nums + i));
+		best = _mm256_blendv_epi8(best, chunk, _mm256_cmpgt_epi64(chunk, best));
+	}
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, best);
+	long long result = maxScalar(lanes, 4);
+	return (i < count) ? max(result, maxScalar(nums + i, count - i)) : result;
+}
+
+//any() and all() look at 16 elements at a time and stop at the first block that decides them
+__attribute__((target("avx2")))
+bool anyAVX2(const long long* nums, size_t count) {
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)(nums + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(nums + i + 4));
+		__m256i c = _mm256_loadu_si256((const __m256i*)(nums + i + 8));
+		__m256i d = _mm256_loadu_si256((const __m256i*)(nums + i + 12));
+		__m256i ored = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if(!_mm256_testz_si256(ored, ored))
+			return true;
+	}
+	return anyScalar(nums + i, count - i);
+}
+
+__attribute__((target("avx2")))
+bool allAVX2(const long long* nums, size_t count) {
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16) {
+		__m256i a = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(nums + i)), zero);
+		__m256i b = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(nums + i + 4)), zero);
+		__m256i c = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(nums + i + 8)), zero);
+		__m256i d = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(nums + i + 12)), zero);
+		__m256i zeros = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if(!_mm256_testz_si256(zeros, zeros))
+			return false;
+	}
+	return allScalar(nums + i, count - i);
+}
+/*==end AVX2==*/
+#endif
+
+/*====kernels====*/
+long long blockSum(const long long* nums, size_t count, unsigned long long &magnitudes) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return blockSumAVX2(nums, count, magnitudes);
+#endif
+	return blockSumScalar(nums, count, magnitudes);
+}
+
+//exact sum of count elements: each block is added up in 64 bits, which can't
+//overflow if its elements' magnitudes are small enough, and otherwise again
+//in 128 bits (the wide path)
+__int128 sumKernel(const long long* nums, size_t count) {
+	__int128 total = 0;
+	for(size_t start=0; start<count; start+=REDUCE_BLOCK) {
+		size_t len = min(REDUCE_BLOCK, count - start);
+		unsigned long long magnitudes = 0;
+		long long sum = blockSum(nums + start, len, magnitudes);
+		//REDUCE_BLOCK (2^12) elements of magnitude at most 2^50 add up to at most 2^62
+		if((magnitudes >> 50) == 0) {
+			total += sum;
+		} else {
+			for(size_t i=start; i<start+len; i++)
+				total += nums[i];
+		}
+	}
+	return total;
+}
+
+long long minKernel(const long long* nums, size_t count) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return minAVX2(nums, count);
+#endif
+	return minScalar(nums, count);
+}
+
+long long maxKernel(const long long* nums, size_t count) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return maxAVX2(nums, count);
+#endif
+	return maxScalar(nums, count);
+}
+
+bool anyKernel(const long long* nums, size_t count) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return anyAVX2(nums, count);
+#endif
+	return anyScalar(nums, count);
+}
+
+bool allKernel(const long long* nums, size_t count) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return allAVX2(nums, count);
+#endif
+	return allScalar(nums, count);
+}
+/*==end kernels==*/
+
+/*====parallel====*/
+//threads that reduce the parts of long lists, started the first time that many
+//are needed and then kept waiting for work, so a reduction doesn't pay for
+//creating threads; the scripts of a batch or a server can hand it parts at once
+class ReducePool {
+	private:
+		vector<thread> workers;
+		deque<function<void()>> tasks;
+		mutex mtx;
+		condition_variable cv;
+		bool stopping = false;
+		
+		void work() {
+			while(true) {
+				function<void()> task;
+				{
+					unique_lock<mutex> lock(mtx);
+					cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+					if(tasks.empty())
+						return;
+					task = move(tasks.front());
+					tasks.pop_front();
+				}
+				task();
+			}
+		}
+		
+	public:
+		ReducePool() {}
+		ReducePool(const ReducePool&) = delete;
+		ReducePool& operator=(const ReducePool&) = delete;
+		
+		~ReducePool() {
+			{
+				lock_guard<mutex> lock(mtx);
+				stopping = true;
+			}
+			cv.notify_all();
+			for(thread &t: workers)
+				t.join();
+		}
+		
+		//runs task(p) for every p below count, task(0) on the calling thread and
+		//the others on the pool's, and returns once all of them have
+		template<class Task>
+		void run(size_t count, Task task) {
+			mutex doneMtx;
+			condition_variable doneCv;
+			size_t remaining = count - 1;
+			{
+				lock_guard<mutex> lock(mtx);
+				while(workers.size() < count - 1)
+					workers.push_back(thread(&ReducePool::work, this));
+				for(size_t p=1; p<count; p++) {
+					tasks.push_back([&task, &doneMtx, &doneCv, &remaining, p] {
+						task(p);
+						lock_guard<mutex> lock(doneMtx);
+						if(--remaining == 0)
+							doneCv.notify_one();
+					});
+				}
+			}
+			cv.notify_all();
+			task(0);
+			unique_lock<mutex> lock(doneMtx);
+			doneCv.wait(lock, [&remaining] { return remaining == 0; });
+		}
+};
+
+ReducePool reducePool;
+
+//kernel's results over contiguous parts of nums, in list order: one part on
+//the calling thread unless the list is long enough to give several threads
+//PARALLEL_REDUCE_PART elements each (count > 0)
+template<class Result, class Kernel>
+vector<Result> reduceParts(const long long* nums, size_t count, Kernel kernel) {
+	unsigned threads = reduceThreads.load();
+	size_t parts = 1;
+	if(count >= PARALLEL_REDUCE_MIN && threads > 1)
+		parts = min<size_t>(threads, count / PARALLEL_REDUCE_PART);
+	
+	vector<Result> results(parts);
+	if(parts == 1) {
+		results[0] = kernel(nums, count);
+		return results;
+	}
+	size_t partLen = count / parts;
+	reducePool.run(parts, [&results, nums, count, parts, partLen, kernel](size_t p) {
+		size_t start = p * partLen;
+		size_t len = (p == parts - 1) ? count - start : partLen;
+		results[p] = kernel(nums + start, len);
+	});
+	return results;
+}
+
+__int128 reduceSum(const long long* nums, size_t count) {
+	if(count == 0)
+		return 0;
+	__int128 total = 0;
+	for(__int128 part: reduceParts<__int128>(nums, count, sumKernel))
+		total += part;
+	return total;
+}
+
+long long reduceMin(const long long* nums, size_t count) {
+	vector<long long> parts = reduceParts<long long>(nums, count, minKernel);
+	return minScalar(parts.data(), parts.size());
+}
+
+long long reduceMax(const long long* nums, size_t count) {
+	vector<long long> parts = reduceParts<long long>(nums, count, maxKernel);
+	return maxScalar(parts.data(), parts.size());
+}
+
+bool reduceAny(const long long* nums, size_t count) {
+	if(count == 0)
+		return false;
+	for(char part: reduceParts<char>(nums, count, anyKernel)) {
+		if(part)
+			return true;
+	}
+	return false;
+}
+
+bool reduceAll(const long long* nums, size_t count) {
+	if(count == 0)
+		return true;
+	for(char part: reduceParts<char>(nums, count, allKernel)) {
+		if(!part)
+			return false;
+	}
+	return true;
+}
+/*==end parallel==*/
+
+#endif
\ No newline at end of file
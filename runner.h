@@ -0,0 +1,289 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "tokens.h"
+#include "lexer.h"
+#include "parser.h"
+#include "ast.h"
+#include "global_scope.h"
+#include "interpreter.h"
+#include "pipeline.h"
+#include "program.h"
+#include "optimizer.h"
+#include "error.h"
+
+using namespace std;
+
+//one run of a script in ctx: starts counting its loop iterations and, if it
+//has a timeout, a timer thread that sets ctx.steps.timedOut at the deadline;
+//the timer is stopped when the run ends
+class RunDeadline {
+	private:
+		thread timer;
+		mutex mtx;
+		condition_variable cv;
+		bool finished = false;
+	
+	public:
+		RunDeadline(InterpreterContext &ctx) {
+			ctx.steps.start(ctx.limits);
+			if(ctx.limits.timeoutMs == 0)
+				return;
+			
+			StepCounter* steps = &ctx.steps;
+			chrono::milliseconds timeout(ctx.limits.timeoutMs);
+			timer = thread([this, steps, timeout] {
+				unique_lock<mutex> lock(mtx);
+				if(!cv.wait_for(lock, timeout, [this] { return finished; }))
+					steps->timedOut.store(true);
+			});
+		}
+		RunDeadline(const RunDeadline&) = delete;
+		RunDeadline& operator=(const RunDeadline&) = delete;
+		
+		~RunDeadline() {
+			if(!timer.joinable())
+				return;
+			{
+				lock_guard<mutex> lock(mtx);
+				finished = true;
+			}
+			cv.notify_one();
+			timer.join();
+		}
+};
+
+//runs a whole program in ctx, lexing, parsing and executing one line at a time
+void runProgram(istream &inputProgram, InterpreterContext &ctx) {
+	LexicalAnalyzer lexer;
+	Parser parse;
+	Interpreter interpret(ctx);
+	
+	string line;
+	int lineCtr = 1;
+	while(getline(inputProgram, line)) {
+		/*====Lexical Analysis====*/
+		lexer.initialize(line, lineCtr);
+		lexer.tokenize();
+		if(inputProgram.peek() == EOF) {
+			lexer.addEndStmntTokenIfNecessary(true);
+		}
+		vector<Token> tokens = lexer.getTokens();
+		//representTokenList(tokens); //debug function
+		/*==end Lexical Analysis*/
+		
+		/*====Parser====*/
+		ASTNode* tree = nullptr;
+		
+		parse.initialize(tokens);
+		parse.parseAndCreateAST();
+		tree = parse.getAST();
+		
+		//representAST(tree); cout << endl; //debug function
+		/*==end Parser==*/
+		
+		/*====Code Interpreter====*/
+		interpret.initialize(tree);
+		interpret.evaluate();
+		/*==end Code Interpreter==*/
+		
+		lineCtr++;
+	}
+}
+
+//runs a program in ctx and reports an error to ctx.out the way the CLI always
+//has; returns the exit code and, if errMsg is given, the error message
+int runScript(istream &inputProgram, InterpreterContext &ctx, bool pipelined=false, string* errMsg=nullptr) {
+	RunDeadline deadline(ctx);
+	try {
+		if(pipelined) {
+			PipelinedRunner runner;
+			runner.run(inputProgram, ctx);
+		} else {
+			runProgram(inputProgram, ctx);
+		}
+	}
+	
+	catch(CreateProgramError& e) {
+		*ctx.out << e.errMsg << e.what() << endl;
+		if(errMsg != nullptr)
+			*errMsg = e.errMsg + e.what();
+		return -1;
+	}
+	
+	if(errMsg != nullptr)
+		*errMsg = "";
+	return 0;
+}
+
+//runs an already compiled program in ctx, reporting an error like runScript
+int runCompiledProgram(CompiledProgram &program, InterpreterContext &ctx) {
+	RunDeadline deadline(ctx);
+	try {
+		executeProgram(program, ctx);
+	}
+	
+	catch(CreateProgramError& e) {
+		*ctx.out << e.errMsg << e.what() << endl;
+		return -1;
+	}
+	
+	return 0;
+}
+
+//writes what the optimizer and the run did, for --stats
+void printRunStats(ostream &os, CompiledProgram &program, InterpreterContext &ctx) {
+	size_t statements = program.deadStores;
+	for(ASTNode* stmt: program.statements) {
+		if(stmt != nullptr)
+			statements++;
+	}
+	
+	os << "--- stats ---" << endl;
+	os << "statements: " << statements << endl;
+	os << "dead stores removed: " << program.deadStores << endl;
+	double typed = (program.typeSites > 0) ? 100.0 * program.typedSites / program.typeSites : 0.0;
+	os << "loop invariants hoisted: " << program.invariantSlots << endl;
+	os << "bounds checks removed: " << program.uncheckedSites << " list accesses in counted loops" << endl;
+	os << "operand types proven: " << fixed << setprecision(1) << typed << "% of sites (" << program.typedSites << " of " << program.typeSites << ")" << endl;
+	if(ctx.memoCapacity > 0) {
+		double rate = (ctx.memoLookups > 0) ? 100.0 * ctx.memoHits / ctx.memoLookups : 0.0;
+		os << "memo hit rate: " << fixed << setprecision(1) << rate << "% (" << ctx.memoHits << " of " << ctx.memoLookups << " lookups)" << endl;
+	}
+	os << "loop iterations: " << ctx.steps.steps() << endl;
+	MemoryBudget &mem = ctx.memory;
+	os << "memory peak: " << mem.totalPeak << " bytes (lists " << mem.peak[A_List] << ", strings " << mem.peak[A_String] << ", frames " << mem.peak[A_Frame] << ")" << endl;
+}
+
+//compiles the whole program and optimizes it before running it in ctx, so
+//the output is the same as runScript's; keepGlobals keeps every variable's
+//final value in ctx, and stats (if given) gets printRunStats() of the run
+int runOptimizedScript(istream &inputProgram, InterpreterContext &ctx, bool keepGlobals, ostream* stats=nullptr, string* errMsg=nullptr) {
+	CompiledProgram* program = compileProgram(inputProgram);
+	optimizeProgram(*program, keepGlobals, ctx.limits.maxMemory != 0);
+	
+	int exitCode = 0;
+	RunDeadline deadline(ctx);
+	try {
+		executeProgram(*program, ctx);
+		if(errMsg != nullptr)
+			*errMsg = "";
+	}
+	
+	catch(CreateProgramError& e) {
+		*ctx.out << e.errMsg << e.what() << endl;
+		if(errMsg != nullptr)
+			*errMsg = e.errMsg + e.what();
+		exitCode = -1;
+	}
+	
+	if(stats != nullptr)
+		printRunStats(*stats, *program, ctx);
+	delete program;
+	return exitCode;
+}
+
+//runs the script in inFile with ctx; returns the exit code
+int runScriptFile(string inFile, InterpreterContext &ctx, bool pipelined=false) {
+	ifstream inputProgram(inFile);
+	
+	//check if file exists
+	if(!inputProgram.is_open()) {
+		*ctx.out << "minipython: can't open file \'" << inFile << "\', no such file in directory" << endl;
+		inputProgram.close();
+		return 0;
+	}
+	
+	int exitCode = runScript(inputProgram, ctx, pipelined);
+	inputProgram.close();
+	return exitCode;
+}
+
+//runs many scripts concurrently on a pool of threads, each with its own
+//InterpreterContext; output is buffered per script and written in input order
+class BatchRunner {
+	private:
+		struct BatchJob {
+			string inFile;
+			ostringstream output;
+			int exitCode = 0;
+			bool done = false;
+		};
+		
+		vector<unique_ptr<BatchJob>> jobs;
+		atomic<size_t> nextJob;
+		ScriptLimits limits; //of every script
+		mutex doneMtx;
+		condition_variable doneCv;
+		
+		void worker() {
+			while(true) {
+				size_t i = nextJob.fetch_add(1);
+				if(i >= jobs.size())
+					return;
+				
+				InterpreterContext ctx;
+				ctx.out = &jobs[i]->output;
+				ctx.setLimits(limits);
+				int exitCode = runScriptFile(jobs[i]->inFile, ctx);
+				
+				lock_guard<mutex> lock(doneMtx);
+				jobs[i]->exitCode = exitCode;
+				jobs[i]->done = true;
+				doneCv.notify_all();
+			}
+		}
+		
+	public:
+		//returns -1 if any script failed, 0 otherwise
+		int run(vector<string> scripts, int numThreads, ostream &out, ScriptLimits inLimits=ScriptLimits()) {
+			limits = inLimits;
+			jobs.clear();
+			for(string s: scripts) {
+				jobs.push_back(unique_ptr<BatchJob>(new BatchJob()));
+				jobs.back()->inFile = s;
+			}
+			nextJob.store(0);
+			
+			size_t workers = (numThreads < 1) ? 1 : numThreads;
+			if(workers > jobs.size())
+				workers = jobs.size();
+			
+			vector<thread> pool;
+			for(size_t i=0; i<workers; i++) {
+				pool.push_back(thread(&BatchRunner::worker, this));
+			}
+			
+			//stream each script's output as soon as it and all scripts before it are done
+			int exitCode = 0;
+			for(unique_ptr<BatchJob> &job: jobs) {
+				unique_lock<mutex> lock(doneMtx);
+				doneCv.wait(lock, [&job] { return job->done; });
+				lock.unlock();
+				
+				out << job->output.str();
+				out.flush();
+				job->output.str("");
+				if(job->exitCode != 0)
+					exitCode = -1;
+			}
+			
+			for(thread &t: pool) {
+				t.join();
+			}
+			return exitCode;
+		}
+};
+
+#endif
\ No newline at end of file
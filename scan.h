@@ -0,0 +1,155 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
+
+using namespace std;
+
+//vectorized span scans used by the lexer; every function returns the index of
+//the first byte at or after pos that ends the span, or len if there is none
+
+enum ScanLevel {SCAN_SCALAR, SCAN_SSE2, SCAN_AVX2};
+
+/*====scalar====*/
+size_t skipBlanksScalar(const char* s, size_t pos, size_t len) {
+	while(pos < len && (s[pos] == ' ' || s[pos] == '\t'))
+		pos++;
+	return pos;
+}
+
+size_t findQuoteScalar(const char* s, size_t pos, size_t len) {
+	while(pos < len && s[pos] != '\"' && s[pos] != '\0')
+		pos++;
+	return pos;
+}
+/*==end scalar==*/
+
+#ifdef SCAN_X86
+/*====SSE2====*/
+__attribute__((target("sse2")))
+size_t skipBlanksSSE2(const char* s, size_t pos, size_t len) {
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+	while(pos + 16 <= len) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(s + pos));
+		__m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab));
+		unsigned mask = ~(unsigned)_mm_movemask_epi8(blank) & 0xffff;
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 16;
+	}
+	return skipBlanksScalar(s, pos, len);
+}
+
+__attribute__((target("sse2")))
+size_t findQuoteSSE2(const char* s, size_t pos, size_t len) {
+	const __m128i quote = _mm_set1_epi8('\"');
+	const __m128i nul = _mm_setzero_si128();
+	while(pos + 16 <= len) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(s + pos));
+		__m128i hit = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, nul));
+		unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 16;
+	}
+	return findQuoteScalar(s, pos, len);
+}
+/*==end SSE2==*/
+
+/*====AVX2====*/
+__attribute__((target("avx2")))
+size_t skipBlanksAVX2(const char* s, size_t pos, size_t len) {
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+	while(pos + 32 <= len) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(s + pos));
+		__m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab));
+		unsigned mask = ~(unsigned)_mm256_movemask_epi8(blank);
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 32;
+	}
+	//tail stays in avx2 code (vex encoded) to avoid sse/avx transitions
+	const __m128i space16 = _mm_set1_epi8(' ');
+	const __m128i tab16 = _mm_set1_epi8('\t');
+	if(pos + 16 <= len) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(s + pos));
+		__m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space16), _mm_cmpeq_epi8(chunk, tab16));
+		unsigned mask = ~(unsigned)_mm_movemask_epi8(blank) & 0xffff;
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 16;
+	}
+	return skipBlanksScalar(s, pos, len);
+}
+
+__attribute__((target("avx2")))
+size_t findQuoteAVX2(const char* s, size_t pos, size_t len) {
+	const __m256i quote = _mm256_set1_epi8('\"');
+	const __m256i nul = _mm256_setzero_si256();
+	while(pos + 32 <= len) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)(s + pos));
+		__m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, nul));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 32;
+	}
+	const __m128i quote16 = _mm_set1_epi8('\"');
+	const __m128i nul16 = _mm_setzero_si128();
+	if(pos + 16 <= len) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*)(s + pos));
+		__m128i hit = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, nul16));
+		unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+		if(mask != 0)
+			return pos + __builtin_ctz(mask);
+		pos += 16;
+	}
+	return findQuoteScalar(s, pos, len);
+}
+/*==end AVX2==*/
+#endif
+
+//best level this cpu supports, checked once at startup
+ScanLevel detectScanLevel() {
+#ifdef SCAN_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+		return SCAN_AVX2;
+	if(__builtin_cpu_supports("sse2"))
+		return SCAN_SSE2;
+#endif
+	return SCAN_SCALAR;
+}
+
+ScanLevel scanLevel = detectScanLevel(); //can be lowered, e.g. by benchmarks
+
+//index of the first non-blank (not ' ' or '\t') byte
+size_t skipBlanks(const char* s, size_t pos, size_t len) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return skipBlanksAVX2(s, pos, len);
+	if(scanLevel == SCAN_SSE2)
+		return skipBlanksSSE2(s, pos, len);
+#endif
+	return skipBlanksScalar(s, pos, len);
+}
+
+//index of the first '"' or '\0' byte, i.e. the end of a string literal body
+size_t findQuote(const char* s, size_t pos, size_t len) {
+#ifdef SCAN_X86
+	if(scanLevel == SCAN_AVX2)
+		return findQuoteAVX2(s, pos, len);
+	if(scanLevel == SCAN_SSE2)
+		return findQuoteSSE2(s, pos, len);
+#endif
+	return findQuoteScalar(s, pos, len);
+}
+
+#endif
\ No newline at end of file
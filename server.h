@@ -0,0 +1,407 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <climits>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include "global_scope.h"
+#include "program.h"
+#include "optimizer.h"
+#include "runner.h"
+
+using namespace std;
+
+/*====wire format====*/
+//every message is a frame: 1 type byte, 4 byte big endian length, payload
+//  client -> server: 'P' absolute script path | 'S' script source
+//  server -> client: 'O' output (one or more lines) ... then 'X' exit code
+const char FRAME_PATH = 'P';
+const char FRAME_SOURCE = 'S';
+const char FRAME_OUTPUT = 'O';
+const char FRAME_EXIT = 'X';
+
+//a request is read from a peer nothing authenticates: its frame (a path or a
+//script's source) may be at most this long, and the server stops waiting for
+//the rest of it after this many seconds without data
+const uint32_t MAX_REQUEST_FRAME = 8 << 20;
+const int REQUEST_TIMEOUT_SECONDS = 10;
+
+//a reset context keeps its symbol table entries (only their values are
+//dropped), so one that ended up with more names than this is freed instead
+//of pooled and the pool can't grow with every distinct script served
+const size_t MAX_POOLED_SYMBOLS = 4096;
+
+bool writeAll(int fd, const char* data, size_t len) {
+	while(len > 0) {
+		ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+		if(n <= 0)
+			return false;
+		data += n;
+		len -= n;
+	}
+	return true;
+}
+
+bool readAll(int fd, char* data, size_t len) {
+	while(len > 0) {
+		ssize_t n = read(fd, data, len);
+		if(n <= 0)
+			return false;
+		data += n;
+		len -= n;
+	}
+	return true;
+}
+
+bool writeFrame(int fd, char type, const string &payload) {
+	unsigned char header[5];
+	uint32_t len = payload.size();
+	header[0] = type;
+	header[1] = (len >> 24) & 0xff;
+	header[2] = (len >> 16) & 0xff;
+	header[3] = (len >> 8) & 0xff;
+	header[4] = len & 0xff;
+	return writeAll(fd, (char*)header, 5) && writeAll(fd, payload.data(), payload.size());
+}
+
+//false if the connection fails or the payload is longer than maxLen
+bool readFrame(int fd, char &type, string &payload, uint32_t maxLen=UINT32_MAX) {
+	unsigned char header[5];
+	if(!readAll(fd, (char*)header, 5))
+		return false;
+	type = header[0];
+	uint32_t len = ((uint32_t)header[1] << 24) | ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 8) | header[4];
+	if(len > maxLen)
+		return false;
+	payload.resize(len);
+	return len == 0 || readAll(fd, &payload[0], len);
+}
+/*==end wire format==*/
+
+//streambuf that sends what a script prints back to the client as output frames,
+//one frame per flush (print() flushes with endl, so output streams line by line)
+class FrameStreamBuf : public streambuf {
+	private:
+		int fd;
+		string pending;
+		bool connected = true;
+		
+	protected:
+		int overflow(int c) {
+			if(c != EOF)
+				pending.push_back((char)c);
+			return c;
+		}
+		
+		streamsize xsputn(const char* s, streamsize n) {
+			pending.append(s, n);
+			return n;
+		}
+		
+		int sync() {
+			//a client that went away just stops receiving output
+			if(!pending.empty() && connected)
+				connected = writeFrame(fd, FRAME_OUTPUT, pending);
+			pending.clear();
+			return 0;
+		}
+		
+	public:
+		FrameStreamBuf(int inFd) {
+			fd = inFd;
+		}
+		
+		bool isConnected() {
+			return connected;
+		}
+};
+
+//daemon serving script runs over a unix domain socket; keeps a pool of warm
+//interpreter contexts and a cache of compiled scripts between requests
+class ScriptServer {
+	private:
+		struct CacheEntry {
+			shared_ptr<CompiledProgram> program;
+			struct timespec mtime;
+			off_t size;
+		};
+		
+		size_t maxCacheEntries;
+		map<string, CacheEntry> cache; //absolute path or "\0" + source -> program
+		deque<string> cacheOrder; //insertion order, oldest evicted first
+		mutex cacheMtx;
+		
+		vector<InterpreterContext*> idleContexts;
+		mutex contextMtx;
+		
+		ScriptLimits limits; //of every request
+		
+		queue<int> pendingConns;
+		mutex connMtx;
+		condition_variable connCv;
+		
+		InterpreterContext* acquireContext() {
+			lock_guard<mutex> lock(contextMtx);
+			if(idleContexts.empty()) {
+				InterpreterContext* ctx = new InterpreterContext();
+				ctx->setLimits(limits);
+				return ctx;
+			}
+			InterpreterContext* ctx = idleContexts.back();
+			idleContexts.pop_back();
+			return ctx;
+		}
+		
+		void releaseContext(InterpreterContext* ctx) {
+			if(ctx->symbolTable.size() > MAX_POOLED_SYMBOLS) {
+				delete ctx;
+				return;
+			}
+			ctx->reset();
+			ctx->out = &cout;
+			lock_guard<mutex> lock(contextMtx);
+			idleContexts.push_back(ctx);
+		}
+		
+		void cacheInsert(const string &key, CacheEntry entry) {
+			lock_guard<mutex> lock(cacheMtx);
+			if(cache.find(key) == cache.end()) {
+				cacheOrder.push_back(key);
+				if(cacheOrder.size() > maxCacheEntries) {
+					cache.erase(cacheOrder.front());
+					cacheOrder.pop_front();
+				}
+			}
+			cache[key] = entry;
+		}
+		
+		//compiled script for a file, recompiled when its size or mtime change;
+		//returns nullptr if the file can't be read
+		shared_ptr<CompiledProgram> compilePath(const string &path) {
+			struct stat st;
+			if(stat(path.c_str(), &st) != 0)
+				return nullptr;
+			
+			{
+				lock_guard<mutex> lock(cacheMtx);
+				map<string, CacheEntry>::iterator it = cache.find(path);
+				if(it != cache.end() && it->second.size == st.st_size &&
+						it->second.mtime.tv_sec == st.st_mtim.tv_sec && it->second.mtime.tv_nsec == st.st_mtim.tv_nsec) {
+					return it->second.program;
+				}
+			}
+			
+			ifstream inputProgram(path);
+			if(!inputProgram.is_open())
+				return nullptr;
+			
+			CacheEntry entry;
+			entry.program = shared_ptr<CompiledProgram>(compileProgram(inputProgram));
+			optimizeProgram(*entry.program, false, limits.maxMemory != 0);
+			entry.mtime = st.st_mtim;
+			entry.size = st.st_size;
+			cacheInsert(path, entry);
+			return entry.program;
+		}
+		
+		shared_ptr<CompiledProgram> compileSource(const string &source) {
+			string key = string(1, '\0') + source;
+			{
+				lock_guard<mutex> lock(cacheMtx);
+				map<string, CacheEntry>::iterator it = cache.find(key);
+				if(it != cache.end())
+					return it->second.program;
+			}
+			
+			istringstream inputProgram(source);
+			CacheEntry entry;
+			entry.program = shared_ptr<CompiledProgram>(compileProgram(inputProgram));
+			optimizeProgram(*entry.program, false, limits.maxMemory != 0);
+			entry.mtime.tv_sec = 0;
+			entry.mtime.tv_nsec = 0;
+			entry.size = source.size();
+			cacheInsert(key, entry);
+			return entry.program;
+		}
+		
+		void handleConnection(int fd) {
+			char type;
+			string payload;
+			if(!readFrame(fd, type, payload, MAX_REQUEST_FRAME) || (type != FRAME_PATH && type != FRAME_SOURCE)) {
+				close(fd);
+				return;
+			}
+			
+			FrameStreamBuf frameBuf(fd);
+			ostream out(&frameBuf);
+			int exitCode = 0;
+			
+			shared_ptr<CompiledProgram> program = (type == FRAME_PATH) ? compilePath(payload) : compileSource(payload);
+			if(program == nullptr) {
+				out << "minipython: can't open file \'" << payload << "\', no such file in directory" << endl;
+			} else {
+				//each request runs in its own (reset) context
+				InterpreterContext* ctx = acquireContext();
+				ctx->out = &out;
+				exitCode = runCompiledProgram(*program, *ctx);
+				releaseContext(ctx);
+			}
+			
+			out.flush();
+			if(frameBuf.isConnected())
+				writeFrame(fd, FRAME_EXIT, to_string(exitCode));
+			close(fd);
+		}
+		
+		void worker() {
+			while(true) {
+				unique_lock<mutex> lock(connMtx);
+				connCv.wait(lock, [this] { return !pendingConns.empty(); });
+				int fd = pendingConns.front();
+				pendingConns.pop();
+				lock.unlock();
+				
+				handleConnection(fd);
+			}
+		}
+		
+	public:
+		ScriptServer(size_t inMaxCacheEntries=1024) {
+			maxCacheEntries = inMaxCacheEntries;
+		}
+		
+		~ScriptServer() {
+			for(InterpreterContext* ctx: idleContexts)
+				delete ctx;
+		}
+		
+		//listens on socketPath and serves requests on numThreads workers, each
+		//run with inLimits; only returns if the socket can't be set up
+		int serve(string socketPath, int numThreads, ScriptLimits inLimits=ScriptLimits()) {
+			limits = inLimits;
+			signal(SIGPIPE, SIG_IGN);
+			
+			sockaddr_un addr;
+			memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			if(socketPath.size() >= sizeof(addr.sun_path)) {
+				cout << "minipython: socket path too long \'" << socketPath << "\'" << endl;
+				return -1;
+			}
+			strcpy(addr.sun_path, socketPath.c_str());
+			
+			int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+			unlink(socketPath.c_str());
+			if(listenFd < 0 || ::bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 128) != 0) {
+				cout << "minipython: can't listen on \'" << socketPath << "\': " << strerror(errno) << endl;
+				return -1;
+			}
+			
+			if(numThreads < 1)
+				numThreads = 1;
+			vector<thread> pool;
+			for(int i=0; i<numThreads; i++) {
+				pool.push_back(thread(&ScriptServer::worker, this));
+			}
+			
+			while(true) {
+				int fd = accept(listenFd, nullptr, nullptr);
+				if(fd < 0)
+					continue;
+				//a client that stalls sending its request doesn't hold a worker forever
+				timeval timeout = {REQUEST_TIMEOUT_SECONDS, 0};
+				setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+				
+				lock_guard<mutex> lock(connMtx);
+				pendingConns.push(fd);
+				connCv.notify_one();
+			}
+		}
+};
+
+//sends a script (a path, or "-" for source on stdin) to a server and copies
+//its output to out; returns the script's exit code
+int runClient(string socketPath, string script, ostream &out) {
+	char type = FRAME_SOURCE;
+	string payload;
+	
+	if(script == "-") {
+		ostringstream source;
+		source << cin.rdbuf();
+		payload = source.str();
+	} else {
+		//same check as a direct invocation
+		ifstream inputProgram(script);
+		if(!inputProgram.is_open()) {
+			out << "minipython: can't open file \'" << script << "\', no such file in directory" << endl;
+			return 0;
+		}
+		inputProgram.close();
+		
+		char resolved[PATH_MAX];
+		if(realpath(script.c_str(), resolved) == nullptr) {
+			out << "minipython: can't open file \'" << script << "\', no such file in directory" << endl;
+			return 0;
+		}
+		type = FRAME_PATH;
+		payload = resolved;
+	}
+	
+	if(payload.size() > MAX_REQUEST_FRAME) {
+		out << "minipython: script too large for the server (over " << MAX_REQUEST_FRAME << " bytes)" << endl;
+		return -1;
+	}
+	
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path)-1);
+	
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+		out << "minipython: can't connect to \'" << socketPath << "\': " << strerror(errno) << endl;
+		if(fd >= 0)
+			close(fd);
+		return -1;
+	}
+	
+	if(!writeFrame(fd, type, payload)) {
+		out << "minipython: lost connection to \'" << socketPath << "\'" << endl;
+		close(fd);
+		return -1;
+	}
+	
+	string frame;
+	while(readFrame(fd, type, frame)) {
+		if(type == FRAME_OUTPUT) {
+			out << frame;
+			out.flush();
+		} else if(type == FRAME_EXIT) {
+			close(fd);
+			return atoi(frame.c_str());
+		}
+	}
+	
+	out << "minipython: lost connection to \'" << socketPath << "\'" << endl;
+	close(fd);
+	return -1;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,238 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lexer.h"
+#include "global_scope.h"
+#include "list_view.h"
+
+using namespace std;
+
+/*====file format====*/
+//a snapshot is every global of a context, in the host's byte order, with
+//every int64 8 byte aligned so lists can use their elements where they are
+//in the mapped file:
+//  header:  "MPYSNAP1", uint32 0x01020304 (byte order), uint32 0, uint64 count
+//  count entries, each:
+//    uint8 type (SNAP_INT or SNAP_LIST), 3 zero bytes, uint32 name length,
+//    the name, zeros up to a multiple of 8
+//    SNAP_INT:  int64 value
+//    SNAP_LIST: uint64 length, then length int64 elements
+const char SNAP_MAGIC[8] = {'M', 'P', 'Y', 'S', 'N', 'A', 'P', '1'};
+const uint32_t SNAP_BYTE_ORDER = 0x01020304;
+const uint8_t SNAP_INT = 1;
+const uint8_t SNAP_LIST = 2;
+/*==end file format==*/
+
+/*====helpers====*/
+//writes to a FILE, remembering whether anything failed
+struct SnapshotWriter {
+	FILE* file;
+	uint64_t offset = 0;
+	bool ok = true;
+	
+	void write(const void* data, size_t len) {
+		if(len != 0 && fwrite(data, 1, len, file) != len)
+			ok = false;
+		offset += len;
+	}
+	
+	void pad() {
+		static const char zeros[8] = {0};
+		write(zeros, (8 - offset % 8) % 8);
+	}
+};
+
+//reads from a mapped file, failing (instead of reading past its end) once
+//anything is out of bounds
+struct SnapshotReader {
+	const char* data;
+	uint64_t size;
+	uint64_t offset = 0;
+	
+	//pointer to the next len bytes, nullptr if there aren't that many
+	const char* take(uint64_t len) {
+		if(len > size - offset)
+			return nullptr;
+		const char* p = data + offset;
+		offset += len;
+		return p;
+	}
+	
+	bool read(void* out, size_t len) {
+		const char* p = take(len);
+		if(p != nullptr)
+			memcpy(out, p, len);
+		return p != nullptr;
+	}
+	
+	bool pad() {
+		return take((8 - offset % 8) % 8) != nullptr;
+	}
+};
+
+//whether a saved name is one a script could have bound: letters and digits,
+//not starting with a digit, and not a keyword
+bool isIdentifier(const string &name) {
+	if(name.empty() || classOf(name[0]) != C_ALPHA)
+		return false;
+	for(char c: name) {
+		if(classOf(c) != C_ALPHA && classOf(c) != C_DIGIT)
+			return false;
+	}
+	return lookupKeyword(name.data(), name.size()) == nullptr;
+}
+/*==end helpers==*/
+
+//writes every global of ctx to path; returns "" or the error. The file is
+//written to a new file of a unique name (mkstemp) next to path and renamed over
+//it, so lists still using the elements of a snapshot restored from path keep
+//reading the old file, and two writers never share a temporary file
+string writeSnapshot(InterpreterContext &ctx, const string &path) {
+	vector<SymbolEntry*> globals;
+	for(SymbolEntry &entry: ctx.symbolTable) {
+		if(entry.generation == ctx.generation && (entry.type == INT || entry.type == LIST))
+			globals.push_back(&entry);
+	}
+	
+	string tmpPath = path + ".XXXXXX";
+	int fd = mkstemp(&tmpPath[0]);
+	if(fd < 0)
+		return "can't write snapshot \'" + path + "\': " + strerror(errno);
+	fchmod(fd, 0644); //mkstemp creates it readable by the owner only
+	FILE* file = fdopen(fd, "wb");
+	if(file == nullptr) {
+		string err = "can't write snapshot \'" + path + "\': " + strerror(errno);
+		close(fd);
+		remove(tmpPath.c_str());
+		return err;
+	}
+	SnapshotWriter out = {file};
+	
+	uint32_t reserved = 0;
+	uint64_t count = globals.size();
+	out.write(SNAP_MAGIC, sizeof(SNAP_MAGIC));
+	out.write(&SNAP_BYTE_ORDER, sizeof(SNAP_BYTE_ORDER));
+	out.write(&reserved, sizeof(reserved));
+	out.write(&count, sizeof(count));
+	
+	for(SymbolEntry* entry: globals) {
+		uint8_t header[4] = {(entry->type == INT) ? SNAP_INT : SNAP_LIST, 0, 0, 0};
+		uint32_t nameLen = entry->name.size();
+		out.write(header, sizeof(header));
+		out.write(&nameLen, sizeof(nameLen));
+		out.write(entry->name.data(), nameLen);
+		out.pad();
+		
+		if(entry->type == INT) {
+			int64_t value = entry->num;
+			out.write(&value, sizeof(value));
+		} else {
+			//the elements as they are stored, one write
+			uint64_t length = entry->list.size();
+			out.write(&length, sizeof(length));
+			out.write(entry->list.begin(), length * sizeof(int64_t));
+		}
+	}
+	
+	if(fclose(file) != 0)
+		out.ok = false;
+	if(!out.ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+		string err = "can't write snapshot \'" + path + "\': " + strerror(errno);
+		remove(tmpPath.c_str());
+		return err;
+	}
+	return "";
+}
+
+//binds every global saved in the snapshot at path in ctx. The file is mapped
+//and lists use their elements where they are in it, so restoring takes time
+//in the number of globals, not elements; pages are read in as lists are first
+//read, and a list is copied out of the file the first time it is written.
+//The mapping lives until no list refers to it. Returns "" or the error; on
+//error the globals read so far stay bound
+string readSnapshot(InterpreterContext &ctx, const string &path) {
+	string invalid = "\'" + path + "\' is not a valid snapshot";
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return "can't open snapshot \'" + path + "\': " + strerror(errno);
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return invalid;
+	}
+	void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(mapped == MAP_FAILED)
+		return "can't map snapshot \'" + path + "\': " + strerror(errno);
+	madvise(mapped, st.st_size, MADV_WILLNEED); //start reading it in
+	size_t mappedSize = st.st_size;
+	shared_ptr<const void> mapping(mapped, [mappedSize](const void* addr) {
+		munmap((void*)addr, mappedSize);
+	});
+	
+	SnapshotReader in = {(const char*)mapped, (uint64_t)st.st_size};
+	string err = "";
+	char magic[8];
+	uint32_t byteOrder = 0;
+	uint32_t reserved = 0;
+	uint64_t count = 0;
+	if(!in.read(magic, sizeof(magic)) || memcmp(magic, SNAP_MAGIC, sizeof(magic)) != 0 || !in.read(&byteOrder, sizeof(byteOrder)) || !in.read(&reserved, sizeof(reserved)) || !in.read(&count, sizeof(count))) {
+		err = invalid;
+	} else if(byteOrder != SNAP_BYTE_ORDER) {
+		err = invalid + " (written on a machine of another byte order)";
+	}
+	
+	try {
+		for(uint64_t i=0; i<count && err == ""; i++) {
+			uint8_t header[4];
+			uint32_t nameLen = 0;
+			const char* name = nullptr;
+			if(!in.read(header, sizeof(header)) || !in.read(&nameLen, sizeof(nameLen)) || (name = in.take(nameLen)) == nullptr || !in.pad()) {
+				err = invalid;
+				break;
+			}
+			string varName(name, nameLen);
+			if(!isIdentifier(varName)) {
+				err = invalid;
+				break;
+			}
+			size_t hash = hashName(varName);
+			
+			if(header[0] == SNAP_INT) {
+				int64_t value = 0;
+				if(!in.read(&value, sizeof(value))) {
+					err = invalid;
+					break;
+				}
+				ctx.setSymbol(varName, hash, value, INT);
+			} else if(header[0] == SNAP_LIST) {
+				uint64_t length = 0;
+				const char* elems = nullptr;
+				if(!in.read(&length, sizeof(length)) || length > (in.size - in.offset) / sizeof(int64_t) || (elems = in.take(length * sizeof(int64_t))) == nullptr) {
+					err = invalid;
+					break;
+				}
+				//8 byte aligned, like every int64 in the file
+				ctx.setList(varName, hash, ListView::external((const long long*)elems, length, mapping, &ctx.memory));
+			} else {
+				err = invalid;
+			}
+		}
+	} catch(MemoryLimitExceeded &e) {
+		err = "snapshot \'" + path + "\' needs more than the memory limit of " + to_string(ctx.memory.limit) + " bytes";
+	}
+	
+	return err;
+}
+
+#endif
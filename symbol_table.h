@@ -0,0 +1,123 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include "ast.h"
+#include "list_view.h"
+
+using namespace std;
+
+//a global variable, with its value inline whatever its type; entries are
+//stamped with the generation they were written in, and entries from older
+//generations count as undefined
+struct SymbolEntry {
+	string name;
+	size_t hash;
+	DataType type; //INT or LIST
+	long long num; //value of an INT
+	ListView list; //value of a LIST
+	unsigned generation = 0;
+	unsigned long version = 0; //write clock at the last write to the variable (or its list)
+};
+
+//the global namespace: open addressing with linear probing over a power of two
+//array of (hash, entry) slots, so a lookup compares cached hashes and touches
+//an entry only when they match. Entries are never removed (a reset bumps the
+//generation instead) and live in a deque, so their addresses stay valid while
+//the slot array grows; the interpreter keeps pointers to them
+class SymbolTable {
+	private:
+		struct Slot {
+			size_t hash;
+			SymbolEntry* entry; //nullptr for an empty slot
+		};
+		vector<Slot> slots;
+		size_t mask = 0;
+		deque<SymbolEntry> entries;
+		
+		//slot holding name, or the empty slot where it would go
+		Slot& probe(const string &name, size_t hash) {
+			size_t i = hash & mask;
+			while(slots[i].entry != nullptr) {
+				if(slots[i].hash == hash && slots[i].entry->name == name)
+					break;
+				i = (i + 1) & mask;
+			}
+			return slots[i];
+		}
+		
+		//doubles the slot array, reinserting entries by their cached hash
+		void grow() {
+			vector<Slot> old;
+			old.swap(slots);
+			slots.assign((old.empty()) ? 64 : old.size() * 2, {0, nullptr});
+			mask = slots.size() - 1;
+			for(Slot &s: old) {
+				if(s.entry == nullptr)
+					continue;
+				size_t i = s.hash & mask;
+				while(slots[i].entry != nullptr)
+					i = (i + 1) & mask;
+				slots[i] = s;
+			}
+		}
+	
+	public:
+		SymbolTable() {
+			grow();
+		}
+		
+		//entry of name, nullptr if it was never bound (whatever its generation)
+		SymbolEntry* find(const string &name, size_t hash) {
+			return probe(name, hash).entry;
+		}
+		
+		//entry of name, created (unbound, generation 0) if there is none
+		SymbolEntry* insert(const string &name, size_t hash) {
+			Slot* slot = &probe(name, hash);
+			if(slot->entry != nullptr)
+				return slot->entry;
+			
+			//keep the load factor under 3/4
+			if((entries.size() + 1) * 4 > slots.size() * 3) {
+				grow();
+				slot = &probe(name, hash);
+			}
+			entries.emplace_back();
+			SymbolEntry* entry = &entries.back();
+			entry->name = name;
+			entry->hash = hash;
+			entry->type = D_NIL;
+			entry->num = 0;
+			slot->hash = hash;
+			slot->entry = entry;
+			return entry;
+		}
+		
+		size_t size() const {
+			return entries.size();
+		}
+		
+		//every entry ever inserted, bound or not, in the order they were inserted
+		deque<SymbolEntry>::iterator begin() {
+			return entries.begin();
+		}
+		deque<SymbolEntry>::iterator end() {
+			return entries.end();
+		}
+		
+		//frees the elements of every list variable, for a reset (whose
+		//entries then count as undefined anyway)
+		void clearLists() {
+			for(SymbolEntry &entry: entries) {
+				if(entry.type == LIST) {
+					entry.type = D_NIL;
+					entry.list = ListView();
+				}
+			}
+		}
+};
+
+#endif
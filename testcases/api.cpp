@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+
+#include "libminipython.h"
+
+using namespace std;
+
+//runs scripts through the embedding API and prints what it returns, for
+//testcases/run.sh to compare with api.out
+
+void printVariable(MiniPython &interpreter, const string &name) {
+	MiniPythonValue val;
+	if(!interpreter.getVariable(name, val)) {
+		cout << name << ": undefined" << endl;
+		return;
+	}
+	cout << name << ":";
+	if(val.type == MP_INT)
+		cout << " " << val.intVal;
+	for(long long elem: val.listVal)
+		cout << " " << elem;
+	cout << endl;
+}
+
+int main() {
+	string output;
+	MiniPython interpreter;
+	interpreter.setOutputBuffer(&output);
+	
+	cout << "run: " << interpreter.runSource("x = 1 + 2\nl = [x, 4]\nprint(x)\n") << endl;
+	cout << "output: " << output;
+	printVariable(interpreter, "x");
+	printVariable(interpreter, "l");
+	
+	//variables outlive a run until reset
+	cout << "run: " << interpreter.runSource("y = x + 1\n") << endl;
+	printVariable(interpreter, "y");
+	interpreter.reset();
+	printVariable(interpreter, "x");
+	printVariable(interpreter, "y");
+	
+	output.clear();
+	cout << "run: " << interpreter.runSource("print(x)\n") << endl;
+	cout << "error: " << interpreter.lastError() << endl;
+	
+	cout << "run: " << interpreter.runSource("z = 5\n", true) << endl;
+	cout << "error: " << interpreter.lastError() << endl;
+	printVariable(interpreter, "z");
+	return 0;
+}
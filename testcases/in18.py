@@ -0,0 +1,8 @@
+#flags: --pipeline
+# a runtime error is reported before the syntax error on a later line,
+# which the parser reaches first
+x = 1
+l = [1]
+print(x)
+y = x + l
+z = = 2
@@ -0,0 +1,4 @@
+#flags: --batch --jobs=2 testcases/in18.py
+# run after in18 in the same batch, which does not share its variables
+print("second: ", 2)
+print(x)
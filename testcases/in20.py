@@ -0,0 +1,7 @@
+#flags: --client $SOCK
+# a script sent to the daemon
+x = 5
+l = [1, 2]
+m = l + l
+print("x: ", x)
+print(m)
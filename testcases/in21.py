@@ -0,0 +1,4 @@
+#flags: --client $SOCK
+# the next request gets a context without the variables of in20
+print(1)
+print(x)
@@ -0,0 +1,6 @@
+#flags: --stats
+# the first store to x and the one to y are dead
+x = 1
+x = 2
+y = 3
+print(x)
@@ -0,0 +1,13 @@
+#flags: --memo --stats
+# a + b is reused until b is written
+a = 1
+b = 2
+t = a + b
+u = a + b
+b = 3
+v = a + b
+w = a + b
+print("t: ", t)
+print("u: ", u)
+print("v: ", v)
+print("w: ", w)
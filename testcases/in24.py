@@ -0,0 +1,16 @@
+# writing to a slice, a copy or the list they came from leaves the others unchanged
+l = [1, 2, 3, 4]
+s = l[1:]
+s[0] = 9
+print(l)
+print(s)
+c = l
+l[2] = 7
+print(l)
+print(s)
+print(c)
+t = l[:]
+l[1:] = s[2:]
+print(l)
+print(t)
+print(s)
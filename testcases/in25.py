@@ -0,0 +1,18 @@
+# builtins over a list, an empty list and range()
+l = [3, 1, 4, 1, 5]
+print(len(l))
+l.append(9)
+print(l)
+print(len(l))
+print(sum(l))
+print(min(l))
+print(max(l))
+
+e = []
+print(len(e))
+print(sum(e))
+
+print(abs(5))
+print(len(range(10)))
+print(sum(range(101)))
+print("max of range: ", max(range(7)))
@@ -0,0 +1,2 @@
+# a name that is not a builtin, followed by "("
+x (1)
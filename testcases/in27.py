@@ -0,0 +1,3 @@
+# a name that is not a builtin, followed by "(" inside print()
+x = 1
+print(x (1))
@@ -0,0 +1,37 @@
+# for over range() and a list, while, if/else and comparisons
+for i in range(3):
+    print(i)
+for i in range(10, 20, 4):
+    print(i)
+for i in range(2, 2):
+    print(i)
+l = [4, 5, 6]
+for x in l:
+    print(x)
+
+n = 0
+while n < 3:
+    n = n + 1
+print(n)
+if n == 3:
+    print("n: ", n)
+else:
+    print(0)
+if n != 3:
+    print(0)
+else:
+    print("n is ", 3)
+
+a = 1 < 2
+b = 2 <= 1
+c = 3 > 2
+d = 2 >= 3
+e = (1 < 3) < 2
+print(a)
+print(b)
+print(c)
+print(d)
+print(e)
+print(range(5))
+print(range(1, 9, 3))
+print(i)
@@ -0,0 +1,2 @@
+# a chained comparison
+x = 1 < 2 < 3
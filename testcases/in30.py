@@ -0,0 +1,3 @@
+# a zero step
+for i in range(1, 5, 0):
+    print(i)
@@ -0,0 +1,4 @@
+# range() stops at the int limit instead of overflowing
+for i in range(9223372036854775805, 9223372036854775807, 3):
+    print(i)
+print(range(9223372036854775805, 9223372036854775807))
@@ -0,0 +1,109 @@
+# enough globals to grow the table several times, read back after it grew
+v0 = 0
+v1 = 7
+v2 = 14
+v3 = 21
+v4 = 28
+v5 = 35
+v6 = 42
+v7 = 49
+v8 = 56
+v9 = 63
+v10 = 70
+v11 = 77
+v12 = 84
+v13 = 91
+v14 = 98
+v15 = 105
+v16 = 112
+v17 = 119
+v18 = 126
+v19 = 133
+v20 = 140
+v21 = 147
+v22 = 154
+v23 = 161
+v24 = 168
+v25 = 175
+v26 = 182
+v27 = 189
+v28 = 196
+v29 = 203
+v30 = 210
+v31 = 217
+v32 = 224
+v33 = 231
+v34 = 238
+v35 = 245
+v36 = 252
+v37 = 259
+v38 = 266
+v39 = 273
+v40 = 280
+v41 = 287
+v42 = 294
+v43 = 301
+v44 = 308
+v45 = 315
+v46 = 322
+v47 = 329
+v48 = 336
+v49 = 343
+v50 = 350
+v51 = 357
+v52 = 364
+v53 = 371
+v54 = 378
+v55 = 385
+v56 = 392
+v57 = 399
+v58 = 406
+v59 = 413
+v60 = 420
+v61 = 427
+v62 = 434
+v63 = 441
+v64 = 448
+v65 = 455
+v66 = 462
+v67 = 469
+v68 = 476
+v69 = 483
+v70 = 490
+v71 = 497
+v72 = 504
+v73 = 511
+v74 = 518
+v75 = 525
+v76 = 532
+v77 = 539
+v78 = 546
+v79 = 553
+v80 = 560
+v81 = 567
+v82 = 574
+v83 = 581
+v84 = 588
+v85 = 595
+v86 = 602
+v87 = 609
+v88 = 616
+v89 = 623
+v90 = 630
+v91 = 637
+v92 = 644
+v93 = 651
+v94 = 658
+v95 = 665
+v96 = 672
+v97 = 679
+v98 = 686
+v99 = 693
+total = v0 + v1 + v50 + v99
+v50 = v99 + 1
+print(v0)
+print(v50)
+print(v99)
+print(total)
+l = [v1, v2, v3]
+print(l)
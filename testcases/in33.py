@@ -0,0 +1,6 @@
+#flags: --max-memory=1M
+# doubling a list until it exceeds the limit
+l = [1, 2, 3]
+print(len(l))
+while 1 < 2:
+    l = l + l
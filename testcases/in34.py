@@ -0,0 +1,5 @@
+#flags: --max-memory=1M
+# a list too big for the limit, overwritten before it is read
+l = range(1000000)
+l = 0
+print(l)
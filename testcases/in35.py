@@ -0,0 +1,3 @@
+#flags: --max-memory=12x
+# a malformed size
+print(1)
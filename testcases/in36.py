@@ -0,0 +1,5 @@
+#flags: --max-steps=1000
+# a loop that outlives its step budget
+i = 0
+while i < 1000000000:
+    i = i + 1
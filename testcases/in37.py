@@ -0,0 +1,5 @@
+#flags: --max-steps=1000 --stats
+# the partial --stats report of a run stopped by its step budget
+i = 0
+for j in range(1000000000):
+    i = i + j
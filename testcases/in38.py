@@ -0,0 +1,5 @@
+#flags: --timeout=50
+# a loop that outlives its timeout
+i = 0
+while i < 1000000000000:
+    i = i + 1
@@ -0,0 +1,3 @@
+#flags: --max-steps=1k
+# a malformed step count
+print(1)
@@ -0,0 +1,3 @@
+#flags: --timeout=5s
+# a malformed timeout
+print(1)
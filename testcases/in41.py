@@ -0,0 +1,7 @@
+#flags: --snapshot-out=$TMP/in41.snap
+# the setup in42 resumes from
+l = range(5)
+l.append(7)
+n = sum(l)
+e = []
+print(n)
@@ -0,0 +1,7 @@
+#flags: --snapshot-in=$TMP/in41.snap
+# resumes from the globals in41 saved
+print(n)
+print(l)
+print(e)
+l.append(n)
+print(len(l))
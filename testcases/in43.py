@@ -0,0 +1,3 @@
+#flags: --snapshot-in=testcases/in43.py
+# a file that is not a snapshot
+print(1)
@@ -0,0 +1,6 @@
+# x = x + k run as a superinstruction overflows like in45
+x = 9223372036854775806
+x = x + 1
+print(x)
+x = x + 1
+print(x)
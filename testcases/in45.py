@@ -0,0 +1,6 @@
+# the same additions as in44, with a + 0 that keeps them from being fused
+x = 9223372036854775806
+x = x + 1 + 0
+print(x)
+x = x + 1 + 0
+print(x)
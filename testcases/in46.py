@@ -0,0 +1,8 @@
+# l[i] = l[i] + k run as a superinstruction fails like in47 out of bounds
+l = [1, 2]
+i = 1
+l[i] = l[i] + 1
+print(l)
+i = 2
+l[i] = l[i] + 1
+print(l)
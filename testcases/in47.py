@@ -0,0 +1,8 @@
+# the same stores as in46, with a + 0 that keeps them from being fused
+l = [1, 2]
+i = 1
+l[i] = l[i] + 1 + 0
+print(l)
+i = 2
+l[i] = l[i] + 1 + 0
+print(l)
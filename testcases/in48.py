@@ -0,0 +1,10 @@
+#flags: --stats
+# n is an int on the first runs of the addition but a list on the last, so
+# the addition is not proven and still raises
+l = [1, 2]
+n = 0
+for i in range(3):
+    if i == 2:
+        n = l
+    t = n + 1
+    print(t)
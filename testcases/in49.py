@@ -0,0 +1,12 @@
+#flags: --stats
+# a hoisted invariant raises where the loop body reads it, after the print
+# before it, and not at all in a loop that never runs
+l = [1, 2]
+i = 0
+while i < 0:
+    t = l[5]
+print(i)
+while i < 3:
+    print(i)
+    t = l[5]
+    i = i + 1
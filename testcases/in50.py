@@ -0,0 +1,7 @@
+#flags: --stats
+# range() goes past the end of l, so its accesses are checked and the fourth raises
+l = [1, 2, 3]
+s = 0
+for i in range(5):
+    s = s + l[i]
+    print(s)
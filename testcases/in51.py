@@ -0,0 +1,19 @@
+# exact sums around the int limit, and any()/all() of long lists
+l = [9223372036854775806, 1]
+print(sum(l))
+l = range(1048576)
+print(sum(l))
+print(min(l))
+print(max(l))
+print(any(l))
+print(all(l))
+l[0] = 1
+print(all(l))
+z = [0, 0, 0]
+print(any(z))
+print(all(z))
+e = []
+print(any(e))
+print(all(e))
+l = [9223372036854775807, 1]
+print(sum(l))
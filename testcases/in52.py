@@ -0,0 +1,4 @@
+# "<=" written with a blank between its characters
+x = 1
+if x < = 2:
+    print(x)
@@ -0,0 +1,4 @@
+# "==" written with a blank between its characters
+x = 5
+if x = = 5:
+    print(x)
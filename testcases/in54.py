@@ -0,0 +1,8 @@
+# ">=" and "!=" without blanks, and "<=" with one on each side
+x = 5
+a = x>=5
+b = x != 4
+c = x <=4
+print(a)
+print(b)
+print(c)
@@ -0,0 +1,3 @@
+#flags: --snapshot-in=testcases/in55.snap
+# a snapshot whose second name has a character no name can have
+print(x)
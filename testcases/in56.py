@@ -0,0 +1,3 @@
+#flags: --snapshot-in=testcases/in56.snap
+# a snapshot whose second name is a keyword
+print(x)
@@ -0,0 +1,47 @@
+#!/bin/sh
+#runs every testcase that has an expected output next to it and compares all
+#it prints, errors included: testcases/inNN.py is run by ./minipython, and
+#testcases/NAME.cpp is a program make test builds against libminipython.a. a
+#script's first line "#flags: ..." gives the options to run it with; $TMP in
+#them is a directory shared by the whole run, so a test can read a file an
+#earlier one (in name order) wrote, and $SOCK the socket of a --serve daemon
+#started for the run. MINIPYTHON names the interpreter to run instead of
+#./minipython and TEST_SUFFIX is appended to the test programs' names, which
+#make test uses to run everything again on the ASan builds
+
+cd "$(dirname "$0")/.." || exit 1
+minipython=${MINIPYTHON:-./minipython}
+tmp=$(mktemp -d) || exit 1
+server=
+trap 'if [ -n "$server" ]; then kill "$server"; fi; rm -rf "$tmp"' EXIT
+
+if grep -q '^#flags:.*\$SOCK' testcases/*.py; then
+	"$minipython" --serve "$tmp/sock" > "$tmp/server.log" 2>&1 &
+	server=$!
+	tries=0
+	while [ ! -S "$tmp/sock" ] && [ "$tries" -lt 50 ]; do
+		sleep 0.1
+		tries=$((tries + 1))
+	done
+fi
+
+passed=0
+failed=0
+for expected in testcases/*.out; do
+	test=${expected%.out}
+	if [ -f "$test.py" ]; then
+		flags=$(sed -n '1s/^#flags://p' "$test.py" | sed "s|\$TMP|$tmp|g; s|\$SOCK|$tmp/sock|g")
+		"$minipython" $flags "$test.py" > "$tmp/actual" 2>&1
+	else
+		"$test$TEST_SUFFIX" > "$tmp/actual" 2>&1
+	fi
+	if diff -u "$expected" "$tmp/actual"; then
+		passed=$((passed + 1))
+	else
+		echo "FAILED: $test"
+		failed=$((failed + 1))
+	fi
+done
+
+echo "$passed passed, $failed failed"
+[ "$failed" -eq 0 ]
@@ -8,8 +8,8 @@ enum TokenType {
 	T_Identifier, T_String_Literal, T_INT,
 	T_Keyword,
 	T_SEPARATOR, T_OpenParen, T_CloseParen, T_OpenBracket, T_CloseBracket,
-	T_Comma, T_Colon, T_StatementEnd, T_EndLine, T_EOF,
-	T_OPERATOR, T_Plus, T_Minus, T_Mult, T_Div, T_Greater, T_Less, T_EQ,
+	T_Comma, T_Colon, T_Dot, T_StatementEnd, T_EndLine, T_EOF,
+	T_OPERATOR, T_Plus, T_Minus, T_Mult, T_Div, T_Greater, T_Less, T_EQ, T_Not,
 	T_NONE
 };
 